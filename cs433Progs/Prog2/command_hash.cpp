@@ -0,0 +1,117 @@
+/**
+ * Assignment 2: Simple UNIX Shell
+ * @file command_hash.cpp
+ * @brief Cache of command names to resolved paths, like the hash builtin of other shells
+ * @version 1.2
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include "command_hash.h"
+
+using namespace std;
+
+/**
+ * @brief A remembered command
+ */
+struct HashEntry {
+    string path;        // resolved program path
+    unsigned hits;      // times the entry was used, shown by the hash builtin
+};
+
+// Command name to resolved path
+static unordered_map<string, HashEntry> command_table;
+
+// PATH the cache was built against; any change invalidates every entry
+static string cached_path;
+
+/**
+ * @brief Drop the cache if PATH changed since it was filled
+ */
+static void check_path() {
+    const char *path = getenv("PATH");
+    if (!path) path = "/bin:/usr/bin";    // execvp's default when PATH is unset
+    if (cached_path != path) {
+        command_table.clear();
+        cached_path = path;
+    }
+}
+
+/**
+ * @brief Search the PATH directories for an executable regular file
+ * @param name Command name without a '/'
+ * @param result Receives the full path
+ * @return true if found
+ */
+static bool search_path(const char *name, string& result) {
+    const char *dir = cached_path.c_str();
+    while (true) {
+        const char *colon = strchr(dir, ':');
+        size_t len = colon ? (size_t)(colon - dir) : strlen(dir);
+
+        // An empty PATH entry means the current directory
+        result.assign(dir, len);
+        if (len == 0) result = ".";
+        result += '/';
+        result += name;
+
+        struct stat st;
+        if (stat(result.c_str(), &st) == 0 && S_ISREG(st.st_mode) && access(result.c_str(), X_OK) == 0) {
+            return true;
+        }
+        if (!colon) return false;
+        dir = colon + 1;
+    }
+}
+
+const char *resolve_command(const char *name) {
+    if (strchr(name, '/')) return name;
+    check_path();
+
+    auto it = command_table.find(name);
+    if (it == command_table.end()) {
+        string path;
+        if (!search_path(name, path)) return NULL;
+        it = command_table.emplace(name, HashEntry{path, 0}).first;
+    }
+    it->second.hits++;
+    return it->second.path.c_str();
+}
+
+void forget_command(const char *name) {
+    command_table.erase(name);
+}
+
+bool hash_builtin(char *args[], int num_args) {
+    if (strcmp(args[0], "hash") != 0) return false;
+    check_path();
+
+    if (num_args == 1) {
+        if (command_table.empty()) {
+            printf("hash: hash table empty\n");
+            return true;
+        }
+        printf("hits\tcommand\n");
+        for (const auto& entry : command_table) {
+            printf("%4u\t%s\n", entry.second.hits, entry.second.path.c_str());
+        }
+    } else if (strcmp(args[1], "-r") == 0) {
+        command_table.clear();
+    } else {
+        for (int i = 1; i < num_args; i++) {
+            string path;
+            if (strchr(args[i], '/')) continue;
+            if (search_path(args[i], path)) {
+                command_table[args[i]] = HashEntry{path, 0};
+            } else {
+                fprintf(stderr, "hash: %s: not found\n", args[i]);
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,31 @@
+/**
+ * Assignment 2: Simple UNIX Shell
+ * @file command_hash.h
+ * @brief Cache of command names to resolved paths, like the hash builtin of other shells
+ * @version 1.2
+ */
+#pragma once
+
+/**
+ * @brief Resolve a command name to the path of the program to execute.
+ *        Names containing a '/' are used as given. Other names are looked up in PATH once
+ *        and remembered; the whole cache is dropped when PATH changes.
+ * @param name Command name, e.g. "ls"
+ * @return the path, valid until the cache changes, or NULL if no PATH directory has it
+ */
+const char *resolve_command(const char *name);
+
+/**
+ * @brief Drop one cached name, e.g. after its program disappeared from the remembered path
+ * @param name Command name
+ */
+void forget_command(const char *name);
+
+/**
+ * @brief Run the hash builtin: "hash" lists the cache, "hash -r" clears it,
+ *        "hash name..." looks the names up and remembers them
+ * @param args Command arguments
+ * @param num_args Number of arguments
+ * @return true if args[0] was "hash"
+ */
+bool hash_builtin(char *args[], int num_args);
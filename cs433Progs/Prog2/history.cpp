@@ -0,0 +1,195 @@
+/**
+ * Assignment 2: Simple UNIX Shell
+ * @file history.cpp
+ * @brief Command history: a fixed-capacity ring buffer with a prefix index and an append-only history file
+ * @version 1.2
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <ctype.h>
+#include <cstring>
+#include "history.h"
+#include "input.h"
+
+using namespace std;
+
+History::History(size_t capacity)
+: ring(capacity), capacity(capacity), last_number(0), fd(-1)
+{
+}
+
+History::~History() {
+    if (fd != -1) close(fd);
+}
+
+void History::remember(const string& command) {
+    string& slot = ring[last_number % capacity];
+
+    // The overwritten command leaves the prefix index unless a newer copy is still in the ring
+    if (last_number >= capacity) {
+        auto it = latest.find(slot);
+        if (it != latest.end() && it->second == last_number + 1 - capacity) {
+            latest.erase(it);
+        }
+    }
+
+    slot = command;
+    last_number++;
+    latest[slot] = last_number;
+}
+
+bool History::open_file(const char *path) {
+    int read_fd = open(path, O_RDONLY | O_CLOEXEC);
+    uint64_t lines = 0;
+    if (read_fd != -1) {
+        LineReader reader(read_fd, 1 << 20);
+        size_t length;
+        char *line;
+        while ((line = reader.read_line(length)) != NULL) {
+            if (length > 0) {
+                remember(string(line, length));
+                lines++;
+            }
+        }
+        close(read_fd);
+    }
+
+    // Compact a file that grew well past what is kept in memory
+    if (lines > 2 * capacity) {
+        string tmp = string(path) + ".tmp";
+        int tmp_fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (tmp_fd != -1) {
+            string text;
+            for (uint64_t n = first(); n <= last(); n++) {
+                text += *get(n);
+                text += '\n';
+            }
+            if (write(tmp_fd, text.data(), text.size()) == (ssize_t)text.size()) {
+                rename(tmp.c_str(), path);
+            }
+            close(tmp_fd);
+            unlink(tmp.c_str());    // no-op after a successful rename
+        }
+    }
+
+    fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    file_path = path;
+    return fd != -1;
+}
+
+void History::add(const string& command) {
+    if (command.empty()) return;
+    remember(command);
+
+    // One append per command, so concurrent shells interleave whole lines
+    if (fd != -1) {
+        string record = command + '\n';
+        if (write(fd, record.data(), record.size()) < 0) {
+            perror("history");
+        }
+    }
+}
+
+const string *History::get(uint64_t number) const {
+    if (number < first() || number > last() || number == 0) return NULL;
+    return &ring[(number - 1) % capacity];
+}
+
+const string *History::find_prefix(const string& prefix) const {
+    auto matches = [&prefix](const string& command) {
+        return command.compare(0, prefix.size(), prefix) == 0;
+    };
+
+    // Recent commands are the usual match, so look at a few of them first
+    uint64_t n = last();
+    for (uint64_t checked = 0; n >= first() && n != 0 && checked < 64; n--, checked++) {
+        if (matches(*get(n))) return get(n);
+    }
+
+    // Otherwise keep walking back, and walk the index keys starting with prefix (they sort at or
+    // after it, before the first key that does not) in step. The first older hit is the answer,
+    // and so is the newest key once the keys run out, so the work is bounded by whichever of the
+    // two is shorter, not by the number of keys sharing a short prefix.
+    const string *best = NULL;
+    uint64_t best_number = 0;
+    auto it = latest.lower_bound(prefix);
+    for (; n >= first() && n != 0; n--) {
+        if (it == latest.end() || !matches(it->first)) return best;
+        if (it->second > best_number) {
+            best_number = it->second;
+            best = &it->first;
+        }
+        ++it;
+
+        if (matches(*get(n))) return get(n);
+    }
+    return best;
+}
+
+void History::clear() {
+    for (string& slot : ring) slot.clear();
+    latest.clear();
+    last_number = 0;
+    if (fd != -1 && ftruncate(fd, 0) != 0) {
+        perror("history");
+    }
+}
+
+void History::print(uint64_t count) const {
+    uint64_t start = last() >= count ? last() - count + 1 : 1;
+    if (start < first()) start = first();
+    for (uint64_t n = start; n <= last() && n != 0; n++) {
+        printf("%5llu  %s\n", (unsigned long long)n, get(n)->c_str());
+    }
+}
+
+bool expand_history(const History& history, string& line, bool& expanded) {
+    expanded = false;
+    if (line.size() < 2 || line[0] != '!' || isspace((unsigned char)line[1]) || line[1] == '=') {
+        return true;
+    }
+
+    // Find the end of the event designator
+    size_t end = 1;
+    const string *event = NULL;
+    if (line[1] == '!') {
+        end = 2;
+        event = history.get(history.last());
+    } else if (isdigit((unsigned char)line[1]) || (line[1] == '-' && line.size() > 2 && isdigit((unsigned char)line[2]))) {
+        end = line[1] == '-' ? 2 : 1;
+        while (end < line.size() && isdigit((unsigned char)line[end])) end++;
+        long long n = atoll(line.c_str() + 1);
+        uint64_t number = n < 0 ? (history.last() + 1 > (uint64_t)-n ? history.last() + 1 + n : 0) : n;
+        event = history.get(number);
+    } else {
+        while (end < line.size() && !isspace((unsigned char)line[end])) end++;
+        event = history.find_prefix(line.substr(1, end - 1));
+    }
+
+    if (!event) {
+        if (history.last() == 0) {
+            printf("No command history\n");
+        } else {
+            fprintf(stderr, "%s: event not found\n", line.substr(0, end).c_str());
+        }
+        return false;
+    }
+    line = *event + line.substr(end);
+    expanded = true;
+    return true;
+}
+
+bool history_builtin(History& history, char *args[], int num_args) {
+    if (strcmp(args[0], "history") != 0) return false;
+    if (num_args > 1 && strcmp(args[1], "-c") == 0) {
+        history.clear();
+    } else if (num_args > 1) {
+        history.print(strtoull(args[1], NULL, 10));
+    } else {
+        history.print(history.last());
+    }
+    return true;
+}
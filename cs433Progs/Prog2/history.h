@@ -0,0 +1,119 @@
+/**
+ * Assignment 2: Simple UNIX Shell
+ * @file history.h
+ * @brief Command history: a fixed-capacity ring buffer with a prefix index and an append-only history file
+ * @version 1.2
+ */
+#pragma once
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#define HISTORY_SIZE 100000 // Number of commands kept in memory
+
+/**
+ * @brief Command history. Commands are numbered from 1 in the order they were added;
+ *        once the ring is full the oldest command is overwritten.
+ */
+class History {
+private:
+    // Ring buffer of commands; command n is stored at (n - 1) % capacity
+    std::vector<std::string> ring;
+    size_t capacity;
+
+    // Number of the most recent command, 0 when nothing was ever added
+    uint64_t last_number;
+
+    // Prefix index: every distinct command in the ring, sorted, with its most recent number
+    std::map<std::string, uint64_t> latest;
+
+    // History file opened for appending, or -1 when history is not persistent
+    int fd;
+    std::string file_path;
+
+    /**
+     * @brief Add a command to memory only
+     */
+    void remember(const std::string& command);
+
+public:
+    /**
+     * @brief Construct an empty history
+     * @param capacity Maximum number of commands kept in memory
+     */
+    explicit History(size_t capacity = HISTORY_SIZE);
+
+    /**
+     * @brief Close the history file
+     */
+    ~History();
+
+    /**
+     * @brief Load the commands saved in a file and append every new command to it
+     * @param path History file; created if missing
+     * @return false if the file could not be opened
+     */
+    bool open_file(const char *path);
+
+    /**
+     * @brief Add a command, and append it to the history file if there is one
+     */
+    void add(const std::string& command);
+
+    /**
+     * @brief Number of the oldest command still in memory
+     */
+    uint64_t first() const { return last_number < ring.size() ? 1 : last_number - ring.size() + 1; }
+
+    /**
+     * @brief Number of the most recent command, 0 if there is none
+     */
+    uint64_t last() const { return last_number; }
+
+    /**
+     * @brief Get a command by number
+     * @return the command, or NULL if it is not in memory
+     */
+    const std::string *get(uint64_t number) const;
+
+    /**
+     * @brief Find the most recent command starting with a prefix, in time bounded by how far back
+     *        it is or by how many distinct commands share the prefix, whichever is less
+     * @return the command, or NULL if none matches
+     */
+    const std::string *find_prefix(const std::string& prefix) const;
+
+    /**
+     * @brief Forget every command and truncate the history file
+     */
+    void clear();
+
+    /**
+     * @brief Print the most recent commands with their numbers
+     * @param count How many to print
+     */
+    void print(uint64_t count) const;
+};
+
+/**
+ * @brief Replace a leading history event in a command line: !! (last command), !n (command n),
+ *        !-n (n commands back) or !prefix (most recent command starting with prefix).
+ *        Text after the event is kept, e.g. "!! | wc".
+ * @param history The history to search
+ * @param line The line; replaced by the expansion
+ * @param expanded Set to true if the line was changed
+ * @return false after printing an error if the event was not found
+ */
+bool expand_history(const History& history, std::string& line, bool& expanded);
+
+/**
+ * @brief Run the history builtin: "history [n]" lists the last n commands (all by default),
+ *        "history -c" clears the history
+ * @param history The history
+ * @param args Command arguments
+ * @param num_args Number of arguments
+ * @return true if args[0] was "history"
+ */
+bool history_builtin(History& history, char *args[], int num_args);
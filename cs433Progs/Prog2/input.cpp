@@ -0,0 +1,184 @@
+/**
+ * Assignment 2: Simple UNIX Shell
+ * @file input.cpp
+ * @brief Growable line reader and in-place tokenizer for command lines of any length
+ * @version 1.2
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <cstring>
+#include "input.h"
+
+LineReader::LineReader(int fd, size_t block_size)
+: fd(fd), buf(block_size), start(0), end(0), eof(false), wake_fd(-1), on_wake(NULL)
+{
+}
+
+LineReader::LineReader(const char *text, size_t length)
+: fd(-1), buf(text, text + length), start(0), end(length), eof(true), wake_fd(-1), on_wake(NULL)
+{
+}
+
+void LineReader::set_wake(int fd, void (*callback)()) {
+    wake_fd = fd;
+    on_wake = callback;
+}
+
+char *LineReader::read_line(size_t& length) {
+    size_t scanned = start;     // bytes before this position hold no newline
+    while (true) {
+        // Return the next complete line if there is one
+        char *newline = (char *)memchr(buf.data() + scanned, '\n', end - scanned);
+        if (newline || (eof && end > start)) {
+            size_t line_start = start;
+            size_t line_end = newline ? newline - buf.data() : end;
+            if (line_end == buf.size()) buf.push_back('\0');  // unterminated last line fills the buffer
+            buf[line_end] = '\0';
+            length = line_end - line_start;
+            start = newline ? line_end + 1 : end;
+            return buf.data() + line_start;
+        }
+        if (eof) return NULL;
+        scanned = end;
+
+        // Make room: slide the partial line to the front, then grow if it is still full
+        if (start > 0) {
+            memmove(&buf[0], &buf[start], end - start);
+            scanned -= start;
+            end -= start;
+            start = 0;
+        }
+        if (buf.size() - end < buf.size() / 2) {
+            buf.resize(buf.size() * 2);
+        }
+
+        // Wait for input; a wake event (e.g. a child exiting) is handled without returning
+        if (wake_fd != -1) {
+            struct pollfd fds[2] = {{fd, POLLIN, 0}, {wake_fd, POLLIN, 0}};
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) continue;
+            } else if (fds[1].revents & POLLIN) {
+                on_wake();
+                if (!(fds[0].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            }
+        }
+
+        ssize_t n = read(fd, &buf[end], buf.size() - end);
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            perror("read");
+            eof = true;
+        } else if (n == 0) {
+            eof = true;
+        } else {
+            end += n;
+        }
+    }
+}
+
+/**
+ * @brief Whether an unquoted character ends a word
+ */
+static bool is_delimiter(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '|' || c == '&' || c == '<' || c == '>';
+}
+
+/**
+ * @brief Recognize the operator starting with c. Redirections with a descriptor number
+ *        (2>, 2>>, 2>&1) are only recognized at the start of a word, which is the only
+ *        place this is called from.
+ * @param c First character of the operator
+ * @param rest The characters after it
+ * @param limit End of the line
+ * @return the operator spelling, or NULL if c does not start one
+ */
+static const char *match_operator(char c, const char *rest, const char *limit) {
+    // Longest spelling first; each is compared against the line after c
+    static const char *const operators[] = {
+        "<<<", "&>>", "2>&1", "2>>", ">&2", "&>", ">>", "2>", "|", "&", "<", ">"
+    };
+    for (const char *op : operators) {
+        if (op[0] != c) continue;
+        size_t len = strlen(op) - 1;
+        if ((size_t)(limit - rest) >= len && memcmp(rest, op + 1, len) == 0) {
+            return op;
+        }
+    }
+    return NULL;
+}
+
+bool tokenize(char *line, size_t length, std::vector<Token>& tokens) {
+    tokens.clear();
+    char *r = line;             // next character to read
+    char *w = line;             // where the current word is written, never ahead of r
+    char *limit = line + length;
+
+    while (r < limit) {
+        char c = *r;
+
+        // Separators
+        if (c == ' ' || c == '\t' || c == '\n') {
+            r++;
+            continue;
+        }
+
+        // Comment to the end of the line
+        if (c == '#') {
+            break;
+        }
+
+        // Operators use static spellings, so they need no room in the line
+        const char *op = match_operator(c, r + 1, limit);
+        if (op) {
+            tokens.push_back(Token{(char *)op, true});
+            r += strlen(op);
+            continue;
+        }
+
+        // A word: copy it down to w, dropping quotes and escape characters
+        char *word = w;
+        while (r < limit && !is_delimiter(*r)) {
+            c = *r++;
+            if (c == '\\') {
+                if (r < limit) *w++ = *r++;
+            } else if (c == '\'' || c == '"') {
+                while (r < limit && *r != c) {
+                    // Inside double quotes only \" \\ \$ and \` are escapes
+                    if (c == '"' && *r == '\\' && r + 1 < limit &&
+                        (r[1] == '"' || r[1] == '\\' || r[1] == '$' || r[1] == '`')) {
+                        r++;
+                    }
+                    *w++ = *r++;
+                }
+                if (r == limit) {
+                    fprintf(stderr, "Unterminated quote\n");
+                    return false;
+                }
+                r++;
+            } else {
+                *w++ = c;
+            }
+        }
+        tokens.push_back(Token{word, false});
+
+        // Terminate the word. When nothing was dropped, w == r and the NUL lands on the
+        // delimiter, so consume the delimiter here before it is lost.
+        if (w == r && r < limit) {
+            c = *r;
+            *w++ = '\0';
+            op = match_operator(c, r + 1, limit);
+            if (op) {
+                tokens.push_back(Token{(char *)op, true});
+                r += strlen(op);
+            } else {
+                r++;
+            }
+        } else {
+            *w++ = '\0';    // safe: either w < r, or w == limit (the line's own NUL)
+        }
+    }
+    return true;
+}
@@ -0,0 +1,78 @@
+/**
+ * Assignment 2: Simple UNIX Shell
+ * @file input.h
+ * @brief Growable line reader and in-place tokenizer for command lines of any length
+ * @version 1.2
+ */
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+
+/**
+ * @brief Reads lines of any length from a file descriptor into one growable buffer.
+ *        Lines are returned in place, NUL-terminated, without the newline.
+ */
+class LineReader {
+private:
+    int fd;                     // descriptor being read
+    std::vector<char> buf;      // bytes read but not yet returned, plus the current line
+    size_t start;               // first byte not yet returned as a line
+    size_t end;                 // one past the last byte read
+    bool eof;                   // the descriptor reached end of file
+    int wake_fd;                // extra descriptor polled while waiting for input, or -1
+    void (*on_wake)();          // called when wake_fd becomes readable
+
+public:
+    /**
+     * @brief Construct a reader
+     * @param fd Descriptor to read lines from
+     * @param block_size Initial buffer size, and the minimum size of each read
+     */
+    explicit LineReader(int fd, size_t block_size = 64 * 1024);
+
+    /**
+     * @brief Construct a reader over text already in memory, e.g. the argument of osh -c
+     * @param text The text, split into lines at each newline
+     * @param length Length of the text
+     */
+    LineReader(const char *text, size_t length);
+
+    /**
+     * @brief While blocked waiting for input, also wait on another descriptor
+     * @param fd Descriptor to poll, e.g. the SIGCHLD self-pipe
+     * @param callback Called each time fd becomes readable; it must drain fd
+     */
+    void set_wake(int fd, void (*callback)());
+
+    /**
+     * @brief Read the next line
+     * @param length Receives the length of the line
+     * @return the line, valid until the next call, or NULL at end of input
+     */
+    char *read_line(size_t& length);
+};
+
+/**
+ * @brief A word or an operator of a command line
+ */
+struct Token {
+    char *text;     // word text (points into the line buffer), or the operator spelling
+    bool op;        // true for an unquoted operator such as | < > &
+};
+
+/**
+ * @brief Split a command line into tokens, in place. Words become NUL-terminated views
+ *        into the line with quotes and backslash escapes removed; nothing is allocated
+ *        beyond growing the token vector.
+ *        Single quotes keep everything literally, double quotes allow \" \\ \$ and \`,
+ *        and a backslash outside quotes escapes the next character.
+ *        Unquoted |, &, <, >, >>, <<<, &>, &>> and >&2 are operators even without
+ *        surrounding spaces, as are 2>, 2>> and 2>&1 at the start of a word, and an
+ *        unquoted # at the start of a word begins a comment that runs to the end of the line.
+ * @param line The line; it is modified
+ * @param length Length of the line
+ * @param tokens Receives the tokens; cleared first
+ * @return false after printing an error if a quote is not terminated
+ */
+bool tokenize(char *line, size_t length, std::vector<Token>& tokens);
@@ -0,0 +1,351 @@
+/**
+ * Assignment 2: Simple UNIX Shell
+ * @file jobs.cpp
+ * @brief Job table for foreground and background pipelines, with SIGCHLD reaping and job control builtins
+ * @version 1.2
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <sys/time.h>
+#include <cstring>
+#include <unordered_map>
+#include "jobs.h"
+
+using namespace std;
+
+bool job_control = false;
+bool time_all = false;
+int last_status = 0;
+
+// Jobs in the order they were started
+static vector<Job> jobs;
+
+// Stage pid to job id, so reaping hundreds of jobs does not scan the table
+static unordered_map<pid_t, int> pid_to_job;
+
+// SIGCHLD self-pipe: the handler writes a byte, the shell drains it and reaps
+static int sigchld_pipe[2] = {-1, -1};
+
+/**
+ * @brief SIGCHLD handler; only async-signal-safe work, the reaping happens in reap_jobs
+ */
+static void sigchld_handler(int) {
+    int saved_errno = errno;
+    ssize_t ignored = write(sigchld_pipe[1], "x", 1);  // a full pipe already means "reap"
+    (void)ignored;
+    errno = saved_errno;
+}
+
+void init_jobs() {
+    if (pipe2(sigchld_pipe, O_CLOEXEC | O_NONBLOCK) == -1) {
+        perror("Pipe failed");
+        return;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = sigchld_handler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGCHLD, &sa, NULL);
+}
+
+int sigchld_fd() {
+    return sigchld_pipe[0];
+}
+
+void give_terminal_to(pid_t pgid) {
+    if (job_control && isatty(STDIN_FILENO)) {
+        tcsetpgrp(STDIN_FILENO, pgid);
+    }
+}
+
+/**
+ * @brief Find a job by id
+ * @return the job, or NULL if there is none
+ */
+static Job *find_job(int id) {
+    for (Job& job : jobs) {
+        if (job.id == id) return &job;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Remove a job from the table
+ */
+static void remove_job(int id) {
+    for (size_t i = 0; i < jobs.size(); i++) {
+        if (jobs[i].id == id) {
+            jobs.erase(jobs.begin() + i);
+            return;
+        }
+    }
+}
+
+int add_job(pid_t pgid, const vector<pid_t>& pids, const string& command, bool timed,
+            chrono::steady_clock::time_point start) {
+    // Reuse the smallest free job number, like other shells
+    int id = 1;
+    while (find_job(id)) id++;
+
+    Job job;
+    job.id = id;
+    job.pgid = pgid;
+    job.pids = pids;
+    job.live = (int)pids.size();
+    job.state = job.live > 0 ? JOB_RUNNING : JOB_DONE;
+    job.status = 0;
+    job.command = command;
+    job.changed = false;
+    job.timed = timed || time_all;
+    job.start = start;
+    if (job.timed) {
+        job.usage.assign(pids.size(), rusage());
+        job.wall.assign(pids.size(), 0.0);
+    }
+    jobs.push_back(job);
+
+    for (pid_t pid : pids) {
+        pid_to_job[pid] = id;
+    }
+    return id;
+}
+
+/**
+ * @brief Record a status reported by wait4 for one child
+ * @param usage Resource usage of the child, meaningful once it terminated
+ */
+static void update_status(pid_t pid, int status, const struct rusage& usage) {
+    auto it = pid_to_job.find(pid);
+    if (it == pid_to_job.end()) return;     // not one of ours, e.g. already dropped
+    Job *job = find_job(it->second);
+    if (!job) {
+        pid_to_job.erase(it);
+        return;
+    }
+
+    if (WIFSTOPPED(status)) {
+        job->state = JOB_STOPPED;
+        job->changed = true;
+    } else if (WIFCONTINUED(status)) {
+        job->state = JOB_RUNNING;
+    } else {
+        pid_to_job.erase(it);
+        if (pid == job->pids.back()) job->status = status;
+        if (job->timed) {
+            for (size_t i = 0; i < job->pids.size(); i++) {
+                if (job->pids[i] != pid) continue;
+                job->usage[i] = usage;
+                job->wall[i] = chrono::duration<double>(chrono::steady_clock::now() - job->start).count();
+            }
+        }
+        if (--job->live == 0) {
+            job->state = JOB_DONE;
+            job->changed = true;
+        }
+    }
+}
+
+void reap_jobs() {
+    char drain[64];
+    while (read(sigchld_pipe[0], drain, sizeof(drain)) > 0) {
+    }
+
+    // wait4 is waitpid plus the child's rusage, which costs nothing extra to collect
+    int status;
+    pid_t pid;
+    struct rusage usage;
+    while ((pid = wait4(-1, &status, WNOHANG | WUNTRACED | WCONTINUED, &usage)) > 0) {
+        update_status(pid, status, usage);
+    }
+}
+
+/**
+ * @brief Human readable state of a job
+ */
+static const char *state_name(const Job& job) {
+    switch (job.state) {
+    case JOB_RUNNING: return "Running";
+    case JOB_STOPPED: return "Stopped";
+    default: return "Done";
+    }
+}
+
+/**
+ * @brief Seconds in a timeval
+ */
+static double seconds(const struct timeval& tv) {
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+/**
+ * @brief Print one line of resource usage to stderr
+ * @param label What the line is about
+ * @param wall Wall clock seconds
+ * @param ru Usage to print; ru_maxrss is in kilobytes on Linux
+ */
+static void print_usage(const char *label, double wall, const struct rusage& ru) {
+    fprintf(stderr, "[time] %8.3fs real %8.3fs user %8.3fs sys  maxrss %6ld KB  ctxsw %ld vol %ld invol  %s\n",
+            wall, seconds(ru.ru_utime), seconds(ru.ru_stime), ru.ru_maxrss, ru.ru_nvcsw, ru.ru_nivcsw, label);
+}
+
+/**
+ * @brief Report the resource usage of a finished timed job: the whole job, then every stage
+ *        of a pipeline. The job's max RSS is that of its largest stage.
+ */
+static void report_usage(const Job& job) {
+    if (!job.timed || job.state != JOB_DONE) return;
+
+    struct rusage total;
+    memset(&total, 0, sizeof(total));
+    double wall = 0;
+    for (size_t i = 0; i < job.usage.size(); i++) {
+        const struct rusage& ru = job.usage[i];
+        timeradd(&total.ru_utime, &ru.ru_utime, &total.ru_utime);
+        timeradd(&total.ru_stime, &ru.ru_stime, &total.ru_stime);
+        if (ru.ru_maxrss > total.ru_maxrss) total.ru_maxrss = ru.ru_maxrss;
+        total.ru_nvcsw += ru.ru_nvcsw;
+        total.ru_nivcsw += ru.ru_nivcsw;
+        if (job.wall[i] > wall) wall = job.wall[i];
+    }
+    print_usage(job.command.c_str(), wall, total);
+
+    if (job.pids.size() > 1) {
+        for (size_t i = 0; i < job.pids.size(); i++) {
+            char label[64];
+            snprintf(label, sizeof(label), "  stage %zu (pid %d)", i + 1, (int)job.pids[i]);
+            print_usage(label, job.wall[i], job.usage[i]);
+        }
+    }
+}
+
+void report_builtin_usage(const std::string& command, std::chrono::steady_clock::time_point start,
+                          const struct rusage& before) {
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+    struct rusage used;
+    getrusage(RUSAGE_SELF, &used);
+    timersub(&used.ru_utime, &before.ru_utime, &used.ru_utime);
+    timersub(&used.ru_stime, &before.ru_stime, &used.ru_stime);
+    used.ru_nvcsw -= before.ru_nvcsw;
+    used.ru_nivcsw -= before.ru_nivcsw;
+    fflush(stdout);         // the built-in's own output comes first, as a job's does
+    print_usage(command.c_str(), wall.count(), used);
+}
+
+void wait_for_job(int id, bool foreground) {
+    Job *job = find_job(id);
+    if (!job) return;
+
+    if (foreground) give_terminal_to(job->pgid);
+
+    // Blocking wait on any child also reaps background jobs that finish meanwhile
+    while (job->state == JOB_RUNNING) {
+        int status;
+        struct rusage usage;
+        pid_t pid = wait4(-1, &status, WUNTRACED, &usage);
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            break;      // ECHILD: nothing left to wait for
+        }
+        update_status(pid, status, usage);
+        job = find_job(id);
+    }
+
+    if (job->state == JOB_DONE) {
+        last_status = WIFSIGNALED(job->status) ? 128 + WTERMSIG(job->status) : WEXITSTATUS(job->status);
+    }
+
+    if (foreground) {
+        give_terminal_to(getpgrp());
+        if (job->state == JOB_STOPPED) {
+            printf("\n[%d]+  Stopped\t\t%s\n", job->id, job->command.c_str());
+            job->changed = false;
+        } else {
+            report_usage(*job);
+            remove_job(id);
+        }
+    }
+}
+
+void notify_jobs() {
+    reap_jobs();
+    for (size_t i = 0; i < jobs.size();) {
+        Job& job = jobs[i];
+        if (job.changed && job_control) {
+            printf("[%d]+  %s\t\t%s\n", job.id, state_name(job), job.command.c_str());
+            job.changed = false;
+        }
+        if (job.state == JOB_DONE) {
+            report_usage(job);
+            jobs.erase(jobs.begin() + i);
+        } else {
+            i++;
+        }
+    }
+}
+
+/**
+ * @brief Resolve a job argument ("%n" or "n"), or the most recent job when there is none
+ * @return the job, or NULL after printing an error
+ */
+static Job *job_from_arg(const char *name, char *arg) {
+    if (!arg) {
+        if (jobs.empty()) {
+            fprintf(stderr, "%s: no current job\n", name);
+            return NULL;
+        }
+        return &jobs.back();
+    }
+    Job *job = find_job(atoi(arg[0] == '%' ? arg + 1 : arg));
+    if (!job) fprintf(stderr, "%s: %s: no such job\n", name, arg);
+    return job;
+}
+
+bool job_builtin(char *args[], int num_args) {
+    const char *name = args[0];
+    char *arg = num_args > 1 ? args[1] : NULL;
+
+    if (strcmp(name, "jobs") == 0) {
+        reap_jobs();
+        for (Job& job : jobs) {
+            printf("[%d]  %s\t\t%s\n", job.id, state_name(job), job.command.c_str());
+            job.changed = false;
+        }
+        notify_jobs();      // drops the finished jobs just listed
+    } else if (strcmp(name, "fg") == 0) {
+        Job *job = job_from_arg(name, arg);
+        if (!job) return true;
+        printf("%s\n", job->command.c_str());
+        job->state = JOB_RUNNING;
+        give_terminal_to(job->pgid);
+        kill(-job->pgid, SIGCONT);
+        wait_for_job(job->id, true);
+    } else if (strcmp(name, "bg") == 0) {
+        Job *job = job_from_arg(name, arg);
+        if (!job) return true;
+        job->state = JOB_RUNNING;
+        kill(-job->pgid, SIGCONT);
+        printf("[%d]+ %s &\n", job->id, job->command.c_str());
+    } else if (strcmp(name, "wait") == 0) {
+        if (arg) {
+            Job *job = job_from_arg(name, arg);
+            if (job) wait_for_job(job->id, false);
+        } else {
+            // Wait for every running job; stopped ones would never finish
+            for (size_t i = 0; i < jobs.size(); i++) {
+                if (jobs[i].state == JOB_RUNNING) wait_for_job(jobs[i].id, false);
+            }
+        }
+        notify_jobs();
+    } else {
+        return false;
+    }
+    return true;
+}
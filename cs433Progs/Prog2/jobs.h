@@ -0,0 +1,116 @@
+/**
+ * Assignment 2: Simple UNIX Shell
+ * @file jobs.h
+ * @brief Job table for foreground and background pipelines, with SIGCHLD reaping and job control builtins
+ * @version 1.2
+ */
+#pragma once
+
+#include <sys/types.h>
+#include <sys/resource.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * @brief State of a job as last reported by waitpid
+ */
+enum JobState {
+    JOB_RUNNING,
+    JOB_STOPPED,
+    JOB_DONE
+};
+
+/**
+ * @brief A pipeline started by the shell; all its processes share one process group
+ */
+struct Job {
+    int id;                     // job number shown as [id]
+    pid_t pgid;                 // process group of the pipeline
+    std::vector<pid_t> pids;    // one pid per started stage
+    int live;                   // stages not yet reaped
+    JobState state;
+    int status;                 // wait status of the last stage
+    std::string command;        // command line as typed, for jobs/fg/bg output
+    bool changed;               // state changed since the user was last told
+
+    // Resource usage, reported when the job finishes if timed is set
+    bool timed;
+    std::chrono::steady_clock::time_point start;    // when the first stage was started
+    std::vector<struct rusage> usage;               // per stage, filled in by wait4
+    std::vector<double> wall;                       // per stage, seconds from start until reaped
+};
+
+// Whether jobs get their own process group and the terminal; only for interactive shells
+extern bool job_control;
+
+// Report the resource usage of every job, not only those started with the time builtin
+extern bool time_all;
+
+// Exit status of the last foreground job (128 + signal if it was killed, 127 if it could not start)
+extern int last_status;
+
+/**
+ * @brief Install the SIGCHLD handler and create the self-pipe it writes to
+ */
+void init_jobs();
+
+/**
+ * @brief Read end of the SIGCHLD self-pipe; it becomes readable when a child changes state
+ */
+int sigchld_fd();
+
+/**
+ * @brief Hand the terminal to a process group if the shell is interactive
+ * @param pgid Process group that becomes the foreground group
+ */
+void give_terminal_to(pid_t pgid);
+
+/**
+ * @brief Add a started pipeline to the job table
+ * @param pgid Process group of the pipeline
+ * @param pids One pid per started stage
+ * @param command Command line as typed
+ * @param timed Print the wall, user and system time, max RSS and context switches of the job
+ *              and each of its stages when it finishes
+ * @param start When the first stage was started, the start of the job's wall time
+ * @return the new job id
+ */
+int add_job(pid_t pgid, const std::vector<pid_t>& pids, const std::string& command, bool timed,
+            std::chrono::steady_clock::time_point start);
+
+/**
+ * @brief Report a timed built-in in the same format as a timed job. A built-in runs in the shell
+ *        itself, so this is the shell's own user and system time and context switches since
+ *        `before`, and the shell's max RSS; children a built-in waits for (fg, wait) are not included.
+ * @param command Command line as typed
+ * @param start When the built-in started, the start of its wall time
+ * @param before getrusage(RUSAGE_SELF) taken just before the built-in ran
+ */
+void report_builtin_usage(const std::string& command, std::chrono::steady_clock::time_point start,
+                          const struct rusage& before);
+
+/**
+ * @brief Wait until a job finishes or stops
+ * @param id Job id
+ * @param foreground Give the job the terminal while waiting and drop it from the table when done
+ */
+void wait_for_job(int id, bool foreground);
+
+/**
+ * @brief Reap every child that changed state, without blocking
+ */
+void reap_jobs();
+
+/**
+ * @brief Report background jobs that finished or stopped since the last prompt, and drop finished ones
+ */
+void notify_jobs();
+
+/**
+ * @brief Run the jobs, fg, bg or wait builtin
+ * @param args Command arguments
+ * @param num_args Number of arguments
+ * @return true if args[0] was a job control builtin
+ */
+bool job_builtin(char *args[], int num_args);
@@ -0,0 +1,220 @@
+/**
+ * Assignment 2: Simple UNIX Shell
+ * @file launch.cpp
+ * @brief Starting pipeline stages as child processes, with posix_spawn or fork + exec
+ * @version 1.2
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <cstring>
+#include <string>
+#include "launch.h"
+#include "command_hash.h"
+
+extern char **environ;
+
+LaunchMode launch_mode = LAUNCH_SPAWN;
+
+// Signals the interactive shell ignores; every child gets their default behavior back
+static const int job_control_signals[] = {SIGINT, SIGQUIT, SIGTSTP, SIGTTIN, SIGTTOU};
+
+/**
+ * @brief Put the text of a here-string, plus a newline, in a pipe the child reads from.
+ *        The text is written before the child starts, so a pipe that cannot hold it is
+ *        replaced by an anonymous memory file.
+ * @return the read descriptor, close-on-exec, or -1
+ */
+static int here_string_fd(const char *text) {
+    std::string body = std::string(text) + '\n';
+
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) == -1) return -1;
+    if (fcntl(fds[1], F_GETPIPE_SZ) < (int)body.size()) {
+        fcntl(fds[1], F_SETPIPE_SZ, (int)body.size());
+    }
+    if (fcntl(fds[1], F_GETPIPE_SZ) >= (int)body.size() &&
+        write(fds[1], body.data(), body.size()) == (ssize_t)body.size()) {
+        close(fds[1]);
+        return fds[0];
+    }
+    close(fds[0]);
+    close(fds[1]);
+
+    int fd = memfd_create("osh-here-string", MFD_CLOEXEC);
+    if (fd == -1) return -1;
+    if (write(fd, body.data(), body.size()) != (ssize_t)body.size() || lseek(fd, 0, SEEK_SET) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool open_redirections(Command& cmd) {
+    for (Redirect& redirect : cmd.redirects) {
+        switch (redirect.kind) {
+        case REDIRECT_INPUT:
+            redirect.fd = open(redirect.word, O_RDONLY | O_CLOEXEC);
+            if (redirect.fd < 0) {
+                perror("Failed to open input file");
+                return false;
+            }
+            break;
+        case REDIRECT_OUTPUT:
+        case REDIRECT_APPEND:
+            redirect.fd = open(redirect.word, O_WRONLY | O_CREAT | O_CLOEXEC |
+                               (redirect.kind == REDIRECT_APPEND ? O_APPEND : O_TRUNC), 0644);
+            if (redirect.fd < 0) {
+                perror("Failed to open output file");
+                return false;
+            }
+            break;
+        case REDIRECT_HERE_STRING:
+            redirect.fd = here_string_fd(redirect.word);
+            if (redirect.fd < 0) {
+                perror("Failed to create here-string");
+                return false;
+            }
+            break;
+        case REDIRECT_DUP:
+            break;
+        }
+    }
+    return true;
+}
+
+void close_redirections(Command& cmd) {
+    for (Redirect& redirect : cmd.redirects) {
+        if (redirect.kind != REDIRECT_DUP && redirect.fd != -1) {
+            close(redirect.fd);
+            redirect.fd = -1;
+        }
+    }
+}
+
+/**
+ * @brief Report a program that could not be executed, as "<name>: command not found"
+ * @param name The command name as typed
+ * @param err The exec or posix_spawn error code
+ */
+static void report_exec_error(const char *name, int err) {
+    if (err == ENOENT) {
+        fprintf(stderr, "%s: command not found\n", name);
+    } else {
+        fprintf(stderr, "%s: %s\n", name, strerror(err));
+    }
+}
+
+/**
+ * @brief Start a stage with fork + execv
+ * @param path Resolved program path
+ */
+static pid_t fork_stage(Command& cmd, const char *path, pid_t pgid, int in_fd, int out_fd) {
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("Fork failed");
+        return -1;
+    }
+
+    if (pid == 0) {  // Child process
+        if (pgid >= 0) setpgid(0, pgid);
+        for (int sig : job_control_signals) {
+            signal(sig, SIG_DFL);
+        }
+        sigset_t empty;
+        sigemptyset(&empty);
+        sigprocmask(SIG_SETMASK, &empty, NULL);
+
+        // dup2 clears close-on-exec on the copy, every other shell descriptor closes at exec
+        if (in_fd != -1) dup2(in_fd, STDIN_FILENO);
+        if (out_fd != -1) dup2(out_fd, STDOUT_FILENO);
+        for (const Redirect& redirect : cmd.redirects) {
+            dup2(redirect.fd, redirect.target);
+        }
+
+        execv(path, cmd.argv.data());
+        execvp(cmd.argv[0], cmd.argv.data());   // the remembered path may be stale
+        report_exec_error(cmd.argv[0], errno);
+        _exit(1);
+    }
+    return pid;
+}
+
+/**
+ * @brief Start a stage with posix_spawn
+ * @param path Resolved program path
+ * @param err Receives the posix_spawn error code when it fails
+ */
+static pid_t spawn_stage(Command& cmd, const char *path, pid_t pgid, int in_fd, int out_fd, int& err) {
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attr;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawnattr_init(&attr);
+
+    // Same setup as the fork path: dup the stdio descriptors, the rest are close-on-exec
+    if (in_fd != -1) posix_spawn_file_actions_adddup2(&actions, in_fd, STDIN_FILENO);
+    if (out_fd != -1) posix_spawn_file_actions_adddup2(&actions, out_fd, STDOUT_FILENO);
+    for (const Redirect& redirect : cmd.redirects) {
+        posix_spawn_file_actions_adddup2(&actions, redirect.fd, redirect.target);
+    }
+
+    // Join the job's process group, restore default signals and an empty signal mask
+    sigset_t defaults, empty;
+    sigemptyset(&defaults);
+    for (int sig : job_control_signals) {
+        sigaddset(&defaults, sig);
+    }
+    sigemptyset(&empty);
+    short flags = POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK;
+    if (pgid >= 0) {
+        posix_spawnattr_setpgroup(&attr, pgid);
+        flags |= POSIX_SPAWN_SETPGROUP;
+    }
+    posix_spawnattr_setsigdefault(&attr, &defaults);
+    posix_spawnattr_setsigmask(&attr, &empty);
+    posix_spawnattr_setflags(&attr, flags);
+
+    pid_t pid;
+    err = posix_spawn(&pid, path, &actions, &attr, cmd.argv.data(), environ);
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    return err == 0 ? pid : -1;
+}
+
+pid_t launch_stage(Command& cmd, pid_t pgid, int in_fd, int out_fd) {
+    // The hash table saves a PATH search (and its failed execs) on every launch
+    const char *path = resolve_command(cmd.argv[0]);
+    if (!path) {
+        report_exec_error(cmd.argv[0], ENOENT);
+        return -1;
+    }
+
+    if (launch_mode == LAUNCH_SPAWN) {
+        int err;
+        pid_t pid = spawn_stage(cmd, path, pgid, in_fd, out_fd, err);
+        if (pid == -1 && err == ENOENT && path != cmd.argv[0]) {
+            // The program moved since it was hashed: look it up again once
+            forget_command(cmd.argv[0]);
+            path = resolve_command(cmd.argv[0]);
+            if (path) pid = spawn_stage(cmd, path, pgid, in_fd, out_fd, err);
+        }
+        if (pid != -1) {
+            return pid;
+        }
+        // The program itself could not be executed: same report as the fork path
+        if (err == ENOENT || err == EACCES || err == ENOEXEC || err == ENOTDIR || err == ELOOP ||
+            err == ENAMETOOLONG) {
+            report_exec_error(cmd.argv[0], err);
+            return -1;
+        }
+        // Anything else is a limitation of posix_spawn here, fall back to fork
+        if (!path) return -1;
+    }
+    return fork_stage(cmd, path, pgid, in_fd, out_fd);
+}
@@ -0,0 +1,76 @@
+/**
+ * Assignment 2: Simple UNIX Shell
+ * @file launch.h
+ * @brief Starting pipeline stages as child processes, with posix_spawn or fork + exec
+ * @version 1.2
+ */
+#pragma once
+
+#include <sys/types.h>
+#include <vector>
+
+/**
+ * @brief Kinds of redirection
+ */
+enum RedirectKind {
+    REDIRECT_INPUT,         // < file
+    REDIRECT_OUTPUT,        // > file, 2> file, the first half of &> file
+    REDIRECT_APPEND,        // >> file, 2>> file, the first half of &>> file
+    REDIRECT_DUP,           // 2>&1, >&2, the second half of &> file
+    REDIRECT_HERE_STRING    // <<< word, fed through a pipe
+};
+
+/**
+ * @brief One redirection of a stage. Redirections are applied in the order they were
+ *        written, after the pipe descriptors, so "> f 2>&1" sends both to f while
+ *        "2>&1 > f" leaves stderr on the pipe or terminal.
+ */
+struct Redirect {
+    RedirectKind kind;
+    int target;             // descriptor in the child: 0, 1 or 2
+    char *word;             // file name or here-string text; NULL for REDIRECT_DUP
+    int fd;                 // REDIRECT_DUP: descriptor copied; otherwise opened by open_redirections
+};
+
+/**
+ * @brief One stage of a pipeline: a program with its arguments and redirections
+ */
+struct Command {
+    std::vector<char*> argv;            // NULL-terminated argument list for exec
+    std::vector<Redirect> redirects;    // in the order they were written
+};
+
+/**
+ * @brief How child processes are started
+ */
+enum LaunchMode {
+    LAUNCH_SPAWN,   // posix_spawn: vfork-style, the shell's page tables are never copied
+    LAUNCH_FORK     // fork + execv, the classic path and the fallback
+};
+
+// Launch mode in use; the shell sets it from the OSH_LAUNCH environment variable
+extern LaunchMode launch_mode;
+
+/**
+ * @brief Open the redirection files of a stage in the shell, and fill the pipes of its
+ *        here-strings. Everything is opened with O_CLOEXEC so that no other child inherits
+ *        it. Errors are reported before anything is started.
+ * @param cmd The stage whose redirections are opened
+ * @return false if a file could not be opened
+ */
+bool open_redirections(Command& cmd);
+
+/**
+ * @brief Close the descriptors opened by open_redirections
+ */
+void close_redirections(Command& cmd);
+
+/**
+ * @brief Start one stage as a child process
+ * @param cmd The stage; its redirections are applied after the pipe descriptors
+ * @param pgid Process group to join, 0 to lead a new group, -1 to stay in the shell's group
+ * @param in_fd Descriptor to use as stdin, or -1 to inherit the shell's
+ * @param out_fd Descriptor to use as stdout, or -1 to inherit the shell's
+ * @return pid of the child, or -1 if it could not be started
+ */
+pid_t launch_stage(Command& cmd, pid_t pgid, int in_fd, int out_fd);
@@ -1,312 +1,432 @@
-/**
- * Assignment 2: Simple UNIX Shell
- * @file prog.cpp
- * @brief This is the main function of a simple UNIX Shell that supports command execution, history, I/O redirection, and pipes
- * @version 1.1
- */
-
-#include <stdio.h>
-#include <unistd.h>
-#include <iostream>
-#include <fcntl.h>
-#include <cstring>
-#include <unistd.h>
-#include <sys/wait.h>
-#include <vector>
-#include <string>
-#include <array>
-#include <signal.h>
-
-using namespace std;
-
-#define MAX_LINE 80 // The maximum length command
-#define HISTORY_SIZE 10 // Size of history buffer
-
-// Global variables for history
-vector<string> history;
-int history_count = 0;
-
-// Forward declaration
-bool execute_command(char *args[], int num_args);
-
-/**
- * @brief parse out the command and arguments from the input command separated by spaces
- * @param command Input command string
- * @param args Array to store parsed arguments
- * @return Number of arguments
- */
-int parse_command(char command[], char *args[])
-{
-    int count = 0;
-    char *token = strtok(command, " \n\t");
-    bool is_background = false;
-    
-    while (token != NULL && count < MAX_LINE/2) {
-        size_t len = strlen(token);
-        
-        // Check if this token ends with &
-        if (len > 0 && token[len-1] == '&') {
-            // Remove the & from the token
-            token[len-1] = '\0';
-            is_background = true;
-            
-            // Only add token if it's not empty after removing &
-            if (strlen(token) > 0) {
-                args[count++] = token;
-            }
-        } else {
-            args[count++] = token;
-        }
-        
-        token = strtok(NULL, " \n\t");
-    }
-    
-    // Add & as a separate argument if command is to run in background
-    if (is_background) {
-        args[count++] = strdup("&");
-    }
-    
-    args[count] = NULL;
-    return count;
-}
-
-/**
- * @brief Get the last command from history
- * @return Last command or empty string if history is empty
- */
-string get_last_command() {
-    if (history.empty()) {
-        printf("No command history\n");
-        return "";
-    }
-    return history.back();
-}
-
-/**
- * @brief Add command to history
- * @param command Command to add
- */
-void add_to_history(const string& command) {
-    if (command.empty() || command == "!!" || command[0] == '!') return;
-    
-    if (history.size() >= HISTORY_SIZE) {
-        history.erase(history.begin());
-    }
-    history.push_back(command);
-    history_count++;
-}
-
-/**
- * @brief Execute a single pipe command (cmd1 | cmd2)
- * @param cmd1 First command and its arguments
- * @param cmd2 Second command and its arguments
- * @return true if successful
- */
-bool execute_pipe(char* cmd1[], char* cmd2[]) {
-    int pipefd[2];
-    pid_t pid1, pid2;
-
-    if (pipe(pipefd) == -1) {
-        perror("Pipe failed");
-        return false;
-    }
-
-    // Create first child (cmd1)
-    pid1 = fork();
-    if (pid1 < 0) {
-        perror("Fork failed");
-        return false;
-    }
-
-    if (pid1 == 0) {  // First child process
-        close(pipefd[0]);  // Close unused read end
-        dup2(pipefd[1], STDOUT_FILENO);  // Redirect stdout to pipe
-        close(pipefd[1]);
-
-        execvp(cmd1[0], cmd1);
-        perror("Command not found");
-        exit(1);
-    }
-
-    // Create second child (cmd2)
-    pid2 = fork();
-    if (pid2 < 0) {
-        perror("Fork failed");
-        return false;
-    }
-
-    if (pid2 == 0) {  // Second child process
-        close(pipefd[1]);  // Close unused write end
-        dup2(pipefd[0], STDIN_FILENO);  // Redirect stdin to pipe
-        close(pipefd[0]);
-
-        execvp(cmd2[0], cmd2);
-        perror("Command not found");
-        exit(1);
-    }
-
-    // Parent process
-    close(pipefd[0]);
-    close(pipefd[1]);
-    waitpid(pid1, NULL, 0);
-    waitpid(pid2, NULL, 0);
-    return true;
-}
-
-/**
- * @brief Execute the command with I/O redirection and pipe support
- * @param args Command arguments
- * @param num_args Number of arguments
- * @return true if command executed successfully
- */
-bool execute_command(char *args[], int num_args) {
-    if (num_args == 0) return true;
-    
-    // Check for background execution
-    bool is_background = false;
-    if (num_args > 0 && strcmp(args[num_args-1], "&") == 0) {
-        is_background = true;
-        args[--num_args] = NULL;  // Remove & from arguments
-    }
-
-    // Check for pipe
-    int pipe_pos = -1;
-    for (int i = 0; i < num_args; i++) {
-        if (strcmp(args[i], "|") == 0) {
-            pipe_pos = i;
-            break;
-        }
-    }
-
-    // Handle pipe command
-    if (pipe_pos != -1) {
-        args[pipe_pos] = NULL;  // Split commands at pipe
-        char **cmd2 = &args[pipe_pos + 1];
-        
-        pid_t pid = fork();
-        if (pid < 0) {
-            perror("Fork failed");
-            return false;
-        }
-        if (pid == 0) {  // Child process
-            execute_pipe(args, cmd2);
-            exit(0);
-        }
-        if (!is_background) {
-            waitpid(pid, NULL, 0);
-        }
-        return true;
-    }
-
-    // Check for redirection
-    int input_fd = -1, output_fd = -1;
-    char *input_file = NULL, *output_file = NULL;
-    int cmd_end = num_args;
-
-    for (int i = 0; i < num_args; i++) {
-        if (strcmp(args[i], "<") == 0 && i + 1 < num_args) {
-            input_file = args[i + 1];
-            cmd_end = i;
-            i++;
-        } else if (strcmp(args[i], ">") == 0 && i + 1 < num_args) {
-            output_file = args[i + 1];
-            cmd_end = i;
-            i++;
-        }
-    }
-    args[cmd_end] = NULL;
-
-    // Execute command
-    pid_t pid = fork();
-    if (pid < 0) {
-        perror("Fork failed");
-        return false;
-    }
-    
-    if (pid == 0) {  // Child process
-        // Handle input redirection
-        if (input_file) {
-            input_fd = open(input_file, O_RDONLY);
-            if (input_fd < 0) {
-                perror("Failed to open input file");
-                exit(1);
-            }
-            dup2(input_fd, STDIN_FILENO);
-            close(input_fd);
-        }
-
-        // Handle output redirection
-        if (output_file) {
-            output_fd = open(output_file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
-            if (output_fd < 0) {
-                perror("Failed to open output file");
-                exit(1);
-            }
-            dup2(output_fd, STDOUT_FILENO);
-            close(output_fd);
-        }
-
-        // Execute command
-        if (execvp(args[0], args) < 0) {
-            perror("Command not found");
-            exit(1);
-        }
-    }
-
-    // Parent process
-    if (!is_background) {
-        waitpid(pid, NULL, 0);
-    }
-    
-    return true;
-}
-
-int main(void)
-{
-    char command[MAX_LINE];       // the command that was entered
-    char *args[MAX_LINE / 2 + 1]; // hold parsed out command line arguments
-    int should_run = 1;           // flag to determine when to exit program
-    string cmd_str;
-
-    while (should_run)
-    {
-        printf("osh>");
-        fflush(stdout);
-        
-        // Read the input command
-        if (!fgets(command, MAX_LINE, stdin)) break;
-        
-        // Save original command
-        cmd_str = string(command);
-        cmd_str = cmd_str.substr(0, cmd_str.length()-1); // Remove newline
-        
-        // Handle history commands
-        if (cmd_str == "!!") {
-            string last_cmd = get_last_command();
-            if (last_cmd.empty()) {
-                continue;
-            }
-            printf("%s\n", last_cmd.c_str());
-            strcpy(command, last_cmd.c_str());
-            strcat(command, "\n");  // Add newline back for parsing
-        }
-        
-        // Parse the input command
-        int num_args = parse_command(command, args);
-        
-        // Handle built-in commands
-        if (num_args > 0) {
-            if (strcmp(args[0], "exit") == 0) {
-                should_run = 0;
-                continue;
-            }
-        }
-        
-        // Execute the command and add to history if successful
-        if (execute_command(args, num_args)) {
-            add_to_history(cmd_str);
-        }
-    }
-    return 0;
-}
-
+/**
+ * Assignment 2: Simple UNIX Shell
+ * @file prog.cpp
+ * @brief This is the main function of a simple UNIX Shell that supports command execution, history, I/O redirection, and pipes.
+ *        Redirections: < > >> 2> 2>> 2>&1 >&2 &> &>> and <<< (here-string), on any pipeline stage
+ * @version 1.2
+ *
+ * Build: g++ -o osh prog.cpp launch.cpp jobs.cpp input.cpp command_hash.cpp history.cpp
+ * Usage: osh                 interactive, prints the osh> prompt
+ *        osh -c "command"    run one command string
+ *        osh script.sh       run a script without prompts
+ *        osh -t ...          also report the wall time of every command
+ *        osh -r ...          report wall/user/sys time, max RSS and context switches of
+ *                            every job, like prefixing each command with the time builtin
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include <iostream>
+#include <fcntl.h>
+#include <cstring>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <vector>
+#include <string>
+#include <array>
+#include <signal.h>
+#include <chrono>
+#include "launch.h"
+#include "jobs.h"
+#include "input.h"
+#include "command_hash.h"
+#include "history.h"
+
+using namespace std;
+
+// Command history, persistent for interactive shells
+History history;
+
+// Forward declaration
+bool execute_command(vector<Token>& tokens, const string& text, bool timed);
+
+/**
+ * @brief Translate a redirection operator into the redirections it stands for
+ * @param op Operator spelling
+ * @param word File name or here-string text, NULL for the operators that take none
+ * @param cmd Stage that receives the redirections
+ * @return false if op is not a redirection
+ */
+bool add_redirect(const char *op, char *word, Command& cmd) {
+    if (strcmp(op, "<") == 0) {
+        cmd.redirects.push_back(Redirect{REDIRECT_INPUT, STDIN_FILENO, word, -1});
+    } else if (strcmp(op, "<<<") == 0) {
+        cmd.redirects.push_back(Redirect{REDIRECT_HERE_STRING, STDIN_FILENO, word, -1});
+    } else if (strcmp(op, ">") == 0 || strcmp(op, ">>") == 0) {
+        RedirectKind kind = op[1] ? REDIRECT_APPEND : REDIRECT_OUTPUT;
+        cmd.redirects.push_back(Redirect{kind, STDOUT_FILENO, word, -1});
+    } else if (strcmp(op, "2>") == 0 || strcmp(op, "2>>") == 0) {
+        RedirectKind kind = op[2] ? REDIRECT_APPEND : REDIRECT_OUTPUT;
+        cmd.redirects.push_back(Redirect{kind, STDERR_FILENO, word, -1});
+    } else if (strcmp(op, "&>") == 0 || strcmp(op, "&>>") == 0) {
+        RedirectKind kind = op[2] ? REDIRECT_APPEND : REDIRECT_OUTPUT;
+        cmd.redirects.push_back(Redirect{kind, STDOUT_FILENO, word, -1});
+        cmd.redirects.push_back(Redirect{REDIRECT_DUP, STDERR_FILENO, NULL, STDOUT_FILENO});
+    } else if (strcmp(op, "2>&1") == 0) {
+        cmd.redirects.push_back(Redirect{REDIRECT_DUP, STDERR_FILENO, NULL, STDOUT_FILENO});
+    } else if (strcmp(op, ">&2") == 0) {
+        cmd.redirects.push_back(Redirect{REDIRECT_DUP, STDOUT_FILENO, NULL, STDERR_FILENO});
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Split the tokens into pipeline stages at each "|" and pull out the redirections
+ *        of every stage
+ * @param tokens Command tokens, without a trailing &
+ * @param stages Receives one Command per stage
+ * @return false if a stage is empty or a redirection has no file name
+ */
+bool parse_pipeline(vector<Token>& tokens, vector<Command>& stages) {
+    stages.clear();
+    stages.emplace_back();
+
+    for (size_t i = 0; i < tokens.size(); i++) {
+        Command& cmd = stages.back();
+        const Token& tok = tokens[i];
+        if (!tok.op) {
+            cmd.argv.push_back(tok.text);
+        } else if (strcmp(tok.text, "|") == 0) {
+            if (cmd.argv.empty()) break;     // reported below as an empty stage
+            cmd.argv.push_back(NULL);
+            stages.emplace_back();
+        } else if (strcmp(tok.text, "2>&1") == 0 || strcmp(tok.text, ">&2") == 0) {
+            add_redirect(tok.text, NULL, cmd);
+        } else if (strcmp(tok.text, "&") != 0) {
+            if (i + 1 >= tokens.size() || tokens[i + 1].op) {
+                fprintf(stderr, "Missing file name after %s\n", tok.text);
+                return false;
+            }
+            add_redirect(tok.text, tokens[++i].text, cmd);
+        } else {
+            fprintf(stderr, "Syntax error near unexpected token '%s'\n", tok.text);
+            return false;
+        }
+    }
+
+    if (stages.back().argv.empty()) {
+        fprintf(stderr, "Invalid null command\n");
+        return false;
+    }
+    stages.back().argv.push_back(NULL);
+    return true;
+}
+
+/**
+ * @brief Start every stage of a pipeline straight from the shell, connected by pipes.
+ *        All stages join one process group whose id is the pid of the first stage.
+ * @param stages The pipeline stages, at least one
+ * @param is_background Whether to return without waiting for the job
+ * @param text Command line as typed, kept in the job table
+ * @param timed Report the job's resource usage when it finishes
+ * @return true if every stage was started
+ */
+bool execute_pipeline(vector<Command>& stages, bool is_background, const string& text, bool timed) {
+    size_t n = stages.size();
+    pid_t pgid = 0;
+    vector<pid_t> pids;
+    int prev_read = -1;     // read end of the pipe feeding the current stage
+    bool ok = true;
+
+    // Open every redirection first so a bad file name starts nothing
+    for (Command& cmd : stages) {
+        if (!open_redirections(cmd)) {
+            for (Command& opened : stages) close_redirections(opened);
+            last_status = 1;
+            return false;
+        }
+    }
+
+    // Children write straight to the descriptors, so anything the shell buffered goes first
+    fflush(stdout);
+    auto start = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < n; i++) {
+        // Every stage but the last writes into a fresh pipe. Both ends are close-on-exec,
+        // so each child keeps only the ends it dup2's onto stdin/stdout.
+        int pipefd[2] = {-1, -1};
+        if (i + 1 < n && pipe2(pipefd, O_CLOEXEC) == -1) {
+            perror("Pipe failed");
+            ok = false;
+            break;
+        }
+
+        // Without job control every stage stays in the shell's process group
+        pid_t pid = launch_stage(stages[i], job_control ? pgid : -1, prev_read, pipefd[1]);
+        if (pid < 0) {
+            ok = false;     // neighbors see EOF or EPIPE on the unused pipe ends
+        } else {
+            // Also set the group from the parent so it is in place before we wait or signal it
+            if (pgid == 0) pgid = pid;
+            if (job_control) setpgid(pid, pgid);
+            pids.push_back(pid);
+        }
+
+        // The shell keeps no pipe ends except the one the next stage will read
+        if (prev_read != -1) close(prev_read);
+        if (pipefd[1] != -1) close(pipefd[1]);
+        prev_read = pipefd[0];
+    }
+    if (prev_read != -1) close(prev_read);
+    for (Command& cmd : stages) close_redirections(cmd);
+
+    if (pids.empty()) {
+        last_status = 127;
+        return false;
+    }
+
+    // Every job goes in the job table; SIGCHLD reaping finds background ones there
+    int id = add_job(pgid, pids, text, timed, start);
+    if (is_background) {
+        if (job_control) printf("[%d] %d\n", id, (int)pgid);
+    } else {
+        wait_for_job(id, true);
+    }
+    return ok;
+}
+
+/**
+ * @brief Execute the command with I/O redirection and pipe support
+ * @param tokens Command tokens
+ * @param text Command line as typed
+ * @param timed Report the resource usage of the job when it finishes
+ * @return true if command executed successfully
+ */
+bool execute_command(vector<Token>& tokens, const string& text, bool timed) {
+    if (tokens.empty()) return true;
+    
+    // Check for background execution
+    bool is_background = false;
+    if (tokens.back().op && strcmp(tokens.back().text, "&") == 0) {
+        is_background = true;
+        tokens.pop_back();  // Remove & from the tokens
+        if (tokens.empty()) return true;
+    }
+
+    // Split into pipeline stages; a plain command is a pipeline of one stage
+    vector<Command> stages;
+    if (!parse_pipeline(tokens, stages)) {
+        last_status = 2;
+        return false;
+    }
+    return execute_pipeline(stages, is_background, text, timed);
+}
+
+/**
+ * @brief Set up the shell's own process group and signal handling for job control
+ * @param interactive Whether commands come from the user rather than from -c or a script
+ */
+void init_shell(bool interactive) {
+    init_jobs();
+    if (!interactive || !isatty(STDIN_FILENO)) return;
+    job_control = true;
+
+    // Job control signals are meant for the foreground job, not the shell itself
+    signal(SIGINT, SIG_IGN);
+    signal(SIGQUIT, SIG_IGN);
+    signal(SIGTSTP, SIG_IGN);
+    signal(SIGTTIN, SIG_IGN);
+    signal(SIGTTOU, SIG_IGN);
+
+    // Put the shell in its own process group and take the terminal
+    setpgid(0, 0);
+    give_terminal_to(getpgrp());
+}
+
+/**
+ * @brief Run the export builtin: "export NAME=value" sets an environment variable for
+ *        the shell and its children (changing PATH also invalidates the command hash)
+ * @param args Command arguments
+ * @param num_args Number of arguments
+ * @return true if args[0] was "export"
+ */
+bool export_builtin(char *args[], int num_args) {
+    if (strcmp(args[0], "export") != 0) return false;
+    for (int i = 1; i < num_args; i++) {
+        char *eq = strchr(args[i], '=');
+        if (!eq || eq == args[i]) {
+            fprintf(stderr, "export: %s: expected NAME=value\n", args[i]);
+            continue;
+        }
+        string name(args[i], eq - args[i]);
+        setenv(name.c_str(), eq + 1, 1);
+    }
+    return true;
+}
+
+/**
+ * @brief Print how to invoke the shell
+ */
+void usage() {
+    fprintf(stderr, "Usage: osh [-t] [-r] [-c command | script]\n");
+    fprintf(stderr, "  -c command  run the command string, then exit\n");
+    fprintf(stderr, "  script      run the commands in the file, then exit\n");
+    fprintf(stderr, "  -t          report the wall time of every command on stderr\n");
+    fprintf(stderr, "  -r          report the resource usage of every job on stderr, as with time\n");
+}
+
+int main(int argc, char *argv[])
+{
+    vector<Token> tokens;             // parsed command line, views into the line
+    vector<char *> words;             // NULL-terminated arguments for builtins
+    int should_run = 1;               // flag to determine when to exit program
+    string cmd_str;
+    string recalled;                  // buffer for a command recalled from history
+
+    // Command line options
+    bool timing = false;              // -t: time every command
+    const char *command_string = NULL;
+    const char *script = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0) {
+            timing = true;
+        } else if (strcmp(argv[i], "-r") == 0) {
+            time_all = true;
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            command_string = argv[++i];
+        } else if (argv[i][0] != '-' && !script) {
+            script = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    bool interactive = !command_string && !script;
+
+    // Batch input is read in large blocks; stdin keeps the prompt and reads what is there
+    LineReader *reader;
+    int script_fd = -1;
+    if (command_string) {
+        reader = new LineReader(command_string, strlen(command_string));
+    } else if (script) {
+        script_fd = open(script, O_RDONLY | O_CLOEXEC);
+        if (script_fd < 0) {
+            perror(script);
+            return 127;
+        }
+        reader = new LineReader(script_fd, 1 << 20);
+    } else {
+        reader = new LineReader(STDIN_FILENO);
+    }
+
+    init_shell(interactive);
+
+    // Interactive history is kept in $OSH_HISTFILE, or ~/.osh_history
+    if (interactive) {
+        const char *histfile = getenv("OSH_HISTFILE");
+        string default_histfile = string(getenv("HOME") ? getenv("HOME") : ".") + "/.osh_history";
+        history.open_file(histfile ? histfile : default_histfile.c_str());
+    }
+
+    // Reap background jobs as soon as they exit, even while waiting for input
+    reader->set_wake(sigchld_fd(), reap_jobs);
+
+    // OSH_LAUNCH=fork selects the classic fork + exec path instead of posix_spawn
+    const char *mode = getenv("OSH_LAUNCH");
+    if (mode && strcmp(mode, "fork") == 0) {
+        launch_mode = LAUNCH_FORK;
+    }
+
+    unsigned long commands_run = 0;
+    auto batch_start = chrono::steady_clock::now();
+
+    while (should_run)
+    {
+        // Reap finished background jobs and tell the user about them
+        notify_jobs();
+
+        if (interactive) {
+            printf("osh>");
+            fflush(stdout);
+        }
+        
+        // Read the input command
+        size_t length;
+        char *command = reader->read_line(length);
+        if (!command) break;
+        
+        // Save original command
+        cmd_str.assign(command, length);
+        
+        // Handle history events: !!, !n, !-n and !prefix
+        bool expanded;
+        if (!expand_history(history, cmd_str, expanded)) {
+            continue;
+        }
+        if (expanded) {
+            printf("%s\n", cmd_str.c_str());
+            recalled = cmd_str;
+            command = &recalled[0];
+            length = recalled.size();
+        }
+        
+        // Parse the input command
+        if (!tokenize(command, length, tokens)) {
+            last_status = 2;
+            continue;
+        }
+        if (tokens.empty()) continue;
+        auto command_start = chrono::steady_clock::now();
+
+        // "time pipeline" reports the resource usage of the job once it finishes; "time builtin"
+        // reports it as soon as the built-in returns
+        bool timed = false;
+        if (!tokens[0].op && strcmp(tokens[0].text, "time") == 0) {
+            if (tokens.size() == 1) {
+                fprintf(stderr, "Usage: time command [| command ...] [&]\n");
+                last_status = 2;
+                continue;
+            }
+            tokens.erase(tokens.begin());
+            timed = true;
+        }
+        
+        // Handle built-in commands
+        bool handled = false;
+        if (!tokens[0].op) {
+            if (strcmp(tokens[0].text, "exit") == 0) {
+                if (tokens.size() > 1) last_status = atoi(tokens[1].text);
+                should_run = 0;
+                continue;
+            }
+            words.clear();
+            for (const Token& tok : tokens) words.push_back(tok.text);
+            words.push_back(NULL);
+            struct rusage before;
+            if (timed) getrusage(RUSAGE_SELF, &before);
+            if (job_builtin(words.data(), (int)tokens.size()) ||
+                hash_builtin(words.data(), (int)tokens.size()) ||
+                export_builtin(words.data(), (int)tokens.size()) ||
+                history_builtin(history, words.data(), (int)tokens.size())) {
+                history.add(cmd_str);
+                handled = true;
+                if (timed) report_builtin_usage(cmd_str, command_start, before);
+            }
+        }
+        
+        // Execute the command and add to history if successful
+        if (!handled && execute_command(tokens, cmd_str, timed)) {
+            history.add(cmd_str);
+        }
+
+        commands_run++;
+        if (timing) {
+            chrono::duration<double> elapsed = chrono::steady_clock::now() - command_start;
+            fprintf(stderr, "[time] %.6fs\t%s\n", elapsed.count(), cmd_str.c_str());
+        }
+    }
+
+    if (timing) {
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - batch_start;
+        fprintf(stderr, "[time] %lu commands in %.6fs (%.1f commands/sec)\n", commands_run,
+                elapsed.count(), commands_run / elapsed.count());
+    }
+
+    delete reader;
+    if (script_fd != -1) close(script_fd);
+    // `exit [N]` returns N (or the last status) in every mode; end of input at the prompt returns 0
+    return (interactive && should_run) ? 0 : last_status;
+}
@@ -0,0 +1,246 @@
+/**
+* Assignment 3: CPU Scheduler
+ * @file bench_scheduler.cpp
+ * @author Oscar Lopez
+ * @brief Benchmark of the templated schedulers against the same schedulers with virtual queue dispatch
+ *        (a stand-in for virtual calls, not the original Scheduler classes).
+ * @version 0.1
+ */
+// Build: g++ -O2 -std=c++17 bench_scheduler.cpp -o bench_scheduler
+// Usage: ./bench_scheduler [dispatches] [processes]
+//
+// Before timing, it checks that save()/restore() round-trips a paused simulation, that a snapshot
+// can branch into another policy, and that truncated snapshots and corrupted counts or priorities
+// are rejected.
+//
+// Each run dispatches about `dispatches` slices (default 10M). The "template" column is the inlined path.
+// The "virtual" column is a stand-in, not the original Scheduler subclasses (those printed every
+// dispatch, so timing them would time the terminal): it uses the same BasicScheduler, but its ready
+// queue forwards every push/pop through a virtual interface, which is what a runtime-polymorphic
+// design pays on each dispatch.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include "scheduler_basic.h"
+
+/**
+ * @brief Abstract ready queue, the runtime-polymorphic counterpart of a queue policy
+ */
+class ReadyQueueInterface {
+public:
+    virtual ~ReadyQueueInterface() {}
+    virtual bool empty() const = 0;
+    virtual void clear() = 0;
+    virtual void push(unsigned int index, const PCB& pcb, unsigned int remaining) = 0;
+    virtual unsigned int pop() = 0;
+};
+
+/**
+ * @brief Wraps a queue policy behind ReadyQueueInterface
+ */
+template <typename QueuePolicy>
+class ReadyQueueImpl : public ReadyQueueInterface {
+private:
+    QueuePolicy queue;
+
+public:
+    bool empty() const override { return queue.empty(); }
+    void clear() override { queue.clear(); }
+    void push(unsigned int index, const PCB& pcb, unsigned int remaining) override {
+        queue.push(index, pcb, remaining);
+    }
+    unsigned int pop() override { return queue.pop(); }
+};
+
+/**
+ * @brief Queue policy that dispatches every operation through a virtual call
+ */
+template <typename QueuePolicy>
+class VirtualQueue {
+private:
+    std::unique_ptr<ReadyQueueInterface> queue;
+
+public:
+    static constexpr bool shows_priority = QueuePolicy::shows_priority;
+    static constexpr bool shows_remaining = QueuePolicy::shows_remaining;
+    static const char* name(bool preemptive) { return QueuePolicy::name(preemptive); }
+
+    VirtualQueue() : queue(new ReadyQueueImpl<QueuePolicy>()) {}
+
+    bool empty() const { return queue->empty(); }
+    void clear() { queue->clear(); }
+    void push(unsigned int index, const PCB& pcb, unsigned int remaining) { queue->push(index, pcb, remaining); }
+    unsigned int pop() { return queue->pop(); }
+};
+
+/**
+ * @brief Build a process list whose total burst gives about `dispatches` slices of `quantum`
+ */
+std::vector<PCB> make_workload(long dispatches, int num_processes, int quantum) {
+    std::vector<PCB> processes;
+    unsigned int burst = (unsigned int)((dispatches / num_processes) * quantum);
+    srand(433);
+    for (int i = 0; i < num_processes; i++) {
+        processes.push_back(PCB("P" + std::to_string(i + 1), i + 1, rand() % 50 + 1, burst));
+    }
+    return processes;
+}
+
+/**
+ * @brief Run one scheduler `rounds` times on the workload and return the simulate() time in seconds
+ */
+template <typename SchedulerType>
+double run(std::vector<PCB>& processes, int quantum, long rounds, unsigned long long& dispatches) {
+    double elapsed = 0;
+    dispatches = 0;
+    for (long r = 0; r < rounds; r++) {
+        SchedulerType scheduler(quantum);
+        scheduler.init(processes);
+        auto start = std::chrono::high_resolution_clock::now();
+        scheduler.simulate();
+        auto end = std::chrono::high_resolution_clock::now();
+        elapsed += std::chrono::duration<double>(end - start).count();
+        dispatches += scheduler.stats().dispatches;
+    }
+    return elapsed;
+}
+
+/**
+ * @brief Compare the templated and virtual variants of one scheduling policy
+ */
+template <typename QueuePolicy, typename PreemptPolicy>
+void compare(const char* label, long dispatches, int num_processes) {
+    // Non-preemptive schedulers dispatch each process once, so they replay a
+    // process list of `num_processes * 100` entries until `dispatches` is reached
+    std::vector<PCB> processes;
+    long rounds = 1;
+    if (PreemptPolicy::preemptive) {
+        processes = make_workload(dispatches, num_processes, 1);
+    } else {
+        int batch = num_processes * 100;
+        processes = make_workload(batch, batch, 1);
+        rounds = std::max(1L, dispatches / batch);
+    }
+
+    unsigned long long n_template = 0, n_virtual = 0;
+    double t_template = run<BasicScheduler<QueuePolicy, PreemptPolicy, SilentMetrics>>(processes, 1, rounds, n_template);
+    double t_virtual = run<BasicScheduler<VirtualQueue<QueuePolicy>, PreemptPolicy, SilentMetrics>>(processes, 1, rounds, n_virtual);
+
+    std::cout << label << "\t" << n_template << " dispatches\t"
+              << "template: " << n_template / t_template / 1e6 << " M/s\t"
+              << "virtual (stand-in): " << n_virtual / t_virtual / 1e6 << " M/s\t"
+              << "speedup: " << t_virtual / t_template << "x" << std::endl;
+}
+
+/**
+ * @brief Check checkpoint/restore on a small Round Robin workload
+ * @return true if every check passed
+ */
+bool check_snapshot() {
+    typedef BasicScheduler<FIFOQueue, TimeQuantum, SilentMetrics> RR;
+    typedef BasicScheduler<PriorityQueue, TimeQuantum, SilentMetrics> PriorityRR;
+    std::vector<PCB> processes = make_workload(2000, 20, 10);
+    bool ok = true;
+
+    // Reference: one uninterrupted run
+    RR reference(10);
+    reference.init(processes);
+    reference.simulate();
+
+    // Pause halfway and save
+    RR paused(10);
+    paused.init(processes);
+    paused.simulate_for(1000);
+    std::stringstream stream(std::ios::in | std::ios::out | std::ios::binary);
+    paused.save(stream);
+    const std::string bytes = stream.str();
+
+    // Resuming under the same policy must finish exactly like the reference
+    std::istringstream in(bytes, std::ios::binary);
+    RR resumed(10);
+    if (!resumed.restore(in)) {
+        std::cerr << "snapshot: restore of a valid snapshot failed" << std::endl;
+        ok = false;
+    } else {
+        resumed.simulate();
+        if (resumed.total_time() != reference.total_time() ||
+            resumed.stats().dispatches != reference.stats().dispatches ||
+            resumed.stats().total_waiting_time != reference.stats().total_waiting_time) {
+            std::cerr << "snapshot: resumed run differs from the uninterrupted run" << std::endl;
+            ok = false;
+        }
+    }
+
+    // Branching into another policy must still finish every process
+    std::istringstream branch_in(bytes, std::ios::binary);
+    PriorityRR branch(10);
+    if (!branch.restore(branch_in)) {
+        std::cerr << "snapshot: restore into Priority RR failed" << std::endl;
+        ok = false;
+    } else {
+        branch.simulate();
+        if (branch.stats().completed_processes != (int)processes.size()) {
+            std::cerr << "snapshot: branched run did not complete every process" << std::endl;
+            ok = false;
+        }
+    }
+
+    // Every truncation must be rejected
+    for (size_t length = 0; length < bytes.size(); length++) {
+        std::istringstream truncated(bytes.substr(0, length), std::ios::binary);
+        RR scheduler(10);
+        if (scheduler.restore(truncated)) {
+            std::cerr << "snapshot: accepted a stream truncated to " << length << " bytes" << std::endl;
+            ok = false;
+        }
+    }
+
+    // A corrupted process count (after magic, time and metrics) must be rejected, not allocated
+    std::string corrupted = bytes;
+    size_t count_offset = 4 + sizeof(int32_t) + sizeof(double) + sizeof(int32_t) + sizeof(uint64_t);
+    corrupted.replace(count_offset, sizeof(uint32_t), sizeof(uint32_t), '\xff');
+    std::istringstream corrupted_in(corrupted, std::ios::binary);
+    RR scheduler(10);
+    if (scheduler.restore(corrupted_in)) {
+        std::cerr << "snapshot: accepted a corrupted process count" << std::endl;
+        ok = false;
+    }
+
+    // A corrupted priority (the first process's, after the count and its id) must be rejected
+    // before the priority queue sizes its levels by it; 0xffffffff + 1 used to wrap to 0
+    size_t priority_offset = count_offset + sizeof(uint32_t) + sizeof(uint32_t);
+    for (uint32_t priority : {0u, 51u, 1000000000u, 0xffffffffu}) {
+        std::string bad_priority = bytes;
+        bad_priority.replace(priority_offset, sizeof(uint32_t),
+                             std::string(reinterpret_cast<const char*>(&priority), sizeof(uint32_t)));
+        std::istringstream bad_priority_in(bad_priority, std::ios::binary);
+        PriorityRR priority_scheduler(10);
+        if (priority_scheduler.restore(bad_priority_in)) {
+            std::cerr << "snapshot: accepted priority " << priority << std::endl;
+            ok = false;
+        }
+    }
+
+    std::cout << "Snapshot checks: " << (ok ? "passed" : "FAILED") << std::endl;
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    if (!check_snapshot()) {
+        return 1;
+    }
+
+    long dispatches = argc > 1 ? atol(argv[1]) : 10000000;
+    int num_processes = argc > 2 ? atoi(argv[2]) : 1000;
+
+    compare<FIFOQueue, NonPreemptive>("FCFS", dispatches, num_processes);
+    compare<ShortestJobQueue, NonPreemptive>("SJF", dispatches, num_processes);
+    compare<PriorityQueue, NonPreemptive>("Priority", dispatches, num_processes);
+    compare<FIFOQueue, TimeQuantum>("RR", dispatches, num_processes);
+    compare<PriorityQueue, TimeQuantum>("PriorityRR", dispatches, num_processes);
+    return 0;
+}
@@ -0,0 +1,245 @@
+/**
+* Assignment 3: CPU Scheduler
+ * @file scheduler_basic.h
+ * @author Oscar Lopez
+ * @brief A policy-based scheduler template. FCFS, SJF, Priority, RR and Priority RR are aliases of it.
+ * @version 0.1
+ */
+// BasicScheduler combines three policies (see scheduler_policies.h):
+//   - QueuePolicy decides which ready process is dispatched next
+//   - PreemptPolicy decides how long a dispatched process may run
+//   - MetricsPolicy records statistics (and optionally a trace) for every dispatch
+// The class is final, so calls made through a concrete scheduler type are not virtual,
+// and the policy calls inside simulate() are resolved and inlined at compile time.
+// It still derives from Scheduler so it can be driven through the common interface.
+// A running simulation can be paused with simulate_for(), checkpointed with save() and
+// resumed, possibly under another policy, with restore().
+
+#ifndef ASSIGN3_SCHEDULER_BASIC_H
+#define ASSIGN3_SCHEDULER_BASIC_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "scheduler.h"
+#include "scheduler_policies.h"
+
+/**
+ * @brief A CPU scheduler assembled from a ready queue, a preemption and a metrics policy.
+ */
+template <typename QueuePolicy, typename PreemptPolicy, typename MetricsPolicy = TraceMetrics>
+class BasicScheduler final : public Scheduler {
+private:
+    // Ready queue holding indices into processes
+    QueuePolicy ready_queue;
+
+    // Decides the length of each CPU slice
+    PreemptPolicy preempt;
+
+    // Statistics for the simulation
+    MetricsPolicy metrics;
+
+    // List of all processes preserved for statistics and reference
+    std::vector<PCB> processes;
+
+    // Remaining burst time of each process
+    std::vector<unsigned int> remaining;
+
+    // Time each process last entered the ready queue, used for waiting time
+    std::vector<int> ready_since;
+
+    // Current time in the simulation
+    int current_time;
+
+public:
+    /**
+     * @brief Construct a new scheduler
+     * @param time_quantum The time slice for preemptive policies, ignored otherwise (default: 10 time units)
+     */
+    explicit BasicScheduler(int time_quantum = 10) : preempt(time_quantum), current_time(0) {}
+
+    /**
+     * @brief Destroy the scheduler
+     */
+    ~BasicScheduler() override {}
+
+    /**
+     * @brief This function is called once before the simulation starts.
+     *        It is used to initialize the scheduler with the provided processes.
+     * @param process_list The list of processes to be scheduled in the simulation.
+     */
+    void init(std::vector<PCB>& process_list) override {
+        processes = process_list;
+        remaining.resize(processes.size());
+        ready_since.resize(processes.size());
+        ready_queue.clear();
+
+        // Enqueue every process in arrival order
+        for (unsigned int i = 0; i < processes.size(); i++) {
+            remaining[i] = processes[i].burst_time;
+            ready_since[i] = processes[i].arrival_time;
+            ready_queue.push(i, processes[i], remaining[i]);
+        }
+    }
+
+    /**
+     * @brief This function is called once after the simulation ends.
+     *        It outputs the statistics and results of the simulation.
+     */
+    void print_results() override {
+        metrics.print(QueuePolicy::name(PreemptPolicy::preemptive), current_time);
+    }
+
+    /**
+     * @brief This function simulates the scheduling of processes in the ready queue.
+     *        It stops when all processes are finished.
+     */
+    void simulate() override {
+        while (step()) {
+        }
+    }
+
+    /**
+     * @brief Dispatch the next ready process for one CPU slice.
+     * @return false if the ready queue was empty and nothing was dispatched
+     */
+    bool step() {
+        if (ready_queue.empty()) {
+            return false;
+        }
+
+        // Pick the next process and account for the time it spent waiting
+        unsigned int index = ready_queue.pop();
+        int waiting_time = current_time - ready_since[index];
+
+        // Run it for one slice
+        unsigned int run = preempt.slice(remaining[index]);
+        current_time += run;
+        remaining[index] -= run;
+
+        // If the process is not finished, put it back in the ready queue
+        if (remaining[index] > 0) {
+            ready_since[index] = current_time;
+            ready_queue.push(index, processes[index], remaining[index]);
+        }
+
+        metrics.on_dispatch(current_time, processes[index], run, remaining[index], waiting_time,
+                            QueuePolicy::shows_priority, QueuePolicy::shows_remaining, PreemptPolicy::preemptive);
+        return true;
+    }
+
+    /**
+     * @brief Run the simulation for at most a number of dispatches, so it can be checkpointed midway.
+     * @param max_dispatches Maximum number of CPU slices to dispatch
+     * @return true if processes are still waiting in the ready queue
+     */
+    bool simulate_for(unsigned long long max_dispatches) {
+        for (unsigned long long i = 0; i < max_dispatches && step(); i++) {
+        }
+        return !ready_queue.empty();
+    }
+
+    /**
+     * @brief Write the full simulation state to a binary snapshot (see scheduler_snapshot.h).
+     * @param out Stream to write to, opened in binary mode
+     * @return true if the snapshot was written successfully
+     */
+    bool save(std::ostream& out) const {
+        out.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        snapshot_write(out, (int32_t)current_time);
+        metrics.save(out);
+
+        // Process table with the per-process progress
+        snapshot_write(out, (uint32_t)processes.size());
+        for (size_t i = 0; i < processes.size(); i++) {
+            const PCB& pcb = processes[i];
+            snapshot_write(out, (uint32_t)pcb.id);
+            snapshot_write(out, (uint32_t)pcb.priority);
+            snapshot_write(out, (uint32_t)pcb.burst_time);
+            snapshot_write(out, (uint32_t)pcb.arrival_time);
+            snapshot_write(out, (uint32_t)remaining[i]);
+            snapshot_write(out, (int32_t)ready_since[i]);
+            snapshot_write_string(out, pcb.name);
+        }
+
+        // Ready queue in dispatch order
+        snapshot_write(out, (uint32_t)ready_queue.size());
+        ready_queue.for_each([&out](unsigned int index) {
+            snapshot_write(out, (uint32_t)index);
+        });
+        return (bool)out;
+    }
+
+    /**
+     * @brief Replace the simulation state with one read from a binary snapshot.
+     *        The snapshot may come from a scheduler with another policy; the ready queue is
+     *        rebuilt through this scheduler's queue policy, in the saved dispatch order.
+     * @param in Stream to read from, opened in binary mode
+     * @return true if the snapshot was valid and restored, false otherwise (state is then unspecified)
+     */
+    bool restore(std::istream& in) {
+        char magic[sizeof(SNAPSHOT_MAGIC)];
+        int32_t time;
+        uint32_t count;
+        if (!in.read(magic, sizeof(magic)) || std::string(magic, sizeof(magic)) !=
+                                                  std::string(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) ||
+            !snapshot_read(in, time) || !metrics.restore(in) || !snapshot_read(in, count)) {
+            return false;
+        }
+        current_time = time;
+
+        // Process table; a corrupted count must not turn into a huge allocation
+        if (count * SNAPSHOT_MIN_PROCESS_BYTES > snapshot_bytes_left(in)) {
+            return false;
+        }
+        processes.assign(count, PCB(""));
+        remaining.resize(count);
+        ready_since.resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t id, priority, burst, arrival, left;
+            int32_t since;
+            if (!snapshot_read(in, id) || !snapshot_read(in, priority) || !snapshot_read(in, burst) ||
+                !snapshot_read(in, arrival) || !snapshot_read(in, left) || !snapshot_read(in, since) ||
+                !snapshot_read_string(in, processes[i].name)) {
+                return false;
+            }
+            // The priority queue sizes its levels by priority, so a corrupted one must not reach it
+            if (priority < SNAPSHOT_MIN_PRIORITY || priority > SNAPSHOT_MAX_PRIORITY) {
+                return false;
+            }
+            processes[i].id = id;
+            processes[i].priority = priority;
+            processes[i].burst_time = burst;
+            processes[i].arrival_time = arrival;
+            remaining[i] = left;
+            ready_since[i] = since;
+        }
+
+        // Ready queue
+        ready_queue.clear();
+        if (!snapshot_read(in, count) || count * sizeof(uint32_t) > snapshot_bytes_left(in)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t index;
+            if (!snapshot_read(in, index) || index >= processes.size()) {
+                return false;
+            }
+            ready_queue.push(index, processes[index], remaining[index]);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Total simulated time so far
+     */
+    int total_time() const { return current_time; }
+
+    /**
+     * @brief Statistics gathered so far
+     */
+    const MetricsPolicy& stats() const { return metrics; }
+};
+
+#endif //ASSIGN3_SCHEDULER_BASIC_H
@@ -0,0 +1,352 @@
+/**
+* Assignment 3: CPU Scheduler
+ * @file scheduler_policies.h
+ * @author Oscar Lopez
+ * @brief Policy classes plugged into BasicScheduler: ready queue ordering, preemption and metrics.
+ * @version 0.1
+ */
+// Every policy here is a plain class with inline, non-virtual members so that the compiler
+// can fold the whole pick-next/enqueue path of BasicScheduler into a single loop.
+// Ready queues hold indices into the scheduler's process table instead of PCB copies,
+// so dispatching a process never copies its name string.
+
+#ifndef ASSIGN3_SCHEDULER_POLICIES_H
+#define ASSIGN3_SCHEDULER_POLICIES_H
+
+#include <deque>
+#include <queue>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <iostream>
+#include "pcb.h"
+#include "scheduler_snapshot.h"
+
+/**
+ * @brief Ready queue policy that dispatches processes in the order they became ready.
+ * Used by FCFS (non-preemptive) and Round Robin (preemptive).
+ */
+class FIFOQueue {
+private:
+    // Process indices in ready order, front is dispatched next
+    std::deque<unsigned int> queue;
+
+public:
+    // FIFO order does not depend on priority, so the trace does not print it
+    static constexpr bool shows_priority = false;
+    // Round Robin's trace gives the burst time left after each slice
+    static constexpr bool shows_remaining = true;
+
+    /**
+     * @brief Name of the scheduling algorithm built from this queue
+     * @param preemptive Whether the scheduler preempts processes after a time quantum
+     */
+    static const char* name(bool preemptive) {
+        return preemptive ? "Round Robin" : "First Come First Serve";
+    }
+
+    bool empty() const { return queue.empty(); }
+    size_t size() const { return queue.size(); }
+    void clear() { queue.clear(); }
+
+    /**
+     * @brief Add a process to the back of the queue
+     * @param index Index of the process in the process table
+     */
+    void push(unsigned int index, const PCB&, unsigned int) {
+        queue.push_back(index);
+    }
+
+    /**
+     * @brief Remove and return the process at the front of the queue
+     */
+    unsigned int pop() {
+        unsigned int index = queue.front();
+        queue.pop_front();
+        return index;
+    }
+
+    /**
+     * @brief Visit the queued processes in dispatch order
+     */
+    template <typename Visitor>
+    void for_each(Visitor visit) const {
+        for (unsigned int index : queue) {
+            visit(index);
+        }
+    }
+};
+
+/**
+ * @brief Ready queue policy that dispatches the process with the shortest remaining burst first.
+ * Ties are broken by process table order, i.e. arrival order.
+ */
+class ShortestJobQueue {
+private:
+    // (remaining burst, process index) pairs, smallest burst on top
+    typedef std::pair<unsigned int, unsigned int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+public:
+    static constexpr bool shows_priority = false;
+    static constexpr bool shows_remaining = true;
+
+    static const char* name(bool) {
+        return "Shortest Job First";
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    void clear() { heap = decltype(heap)(); }
+
+    /**
+     * @brief Add a process keyed by its remaining burst time
+     * @param index Index of the process in the process table
+     * @param remaining Remaining burst time of the process
+     */
+    void push(unsigned int index, const PCB&, unsigned int remaining) {
+        heap.push(Entry(remaining, index));
+    }
+
+    /**
+     * @brief Remove and return the process with the shortest remaining burst
+     */
+    unsigned int pop() {
+        unsigned int index = heap.top().second;
+        heap.pop();
+        return index;
+    }
+
+    /**
+     * @brief Visit the queued processes in dispatch order
+     */
+    template <typename Visitor>
+    void for_each(Visitor visit) const {
+        std::vector<Entry> entries(heap.size());
+        auto copy = heap;
+        for (size_t i = 0; i < entries.size(); i++) {
+            entries[i] = copy.top();
+            copy.pop();
+        }
+        for (const Entry& entry : entries) {
+            visit(entry.second);
+        }
+    }
+};
+
+/**
+ * @brief Ready queue policy that dispatches the highest priority process first (larger number wins).
+ * Processes with the same priority are served in FIFO order.
+ */
+class PriorityQueue {
+private:
+    // One FIFO per priority level, indexed directly by priority (range 1-50)
+    std::vector<std::deque<unsigned int>> levels;
+
+    // Highest priority level that may still be non-empty
+    unsigned int top_level = 0;
+
+    // Total number of queued processes
+    size_t queued = 0;
+
+public:
+    static constexpr bool shows_priority = true;
+    // Priority Round Robin's trace only gives the slice length
+    static constexpr bool shows_remaining = false;
+
+    static const char* name(bool preemptive) {
+        return preemptive ? "Priority Round Robin" : "Priority";
+    }
+
+    bool empty() const { return queued == 0; }
+    size_t size() const { return queued; }
+
+    void clear() {
+        levels.clear();
+        top_level = 0;
+        queued = 0;
+    }
+
+    /**
+     * @brief Add a process to the back of its priority level
+     * @param index Index of the process in the process table
+     * @param pcb The process, used for its priority
+     */
+    void push(unsigned int index, const PCB& pcb, unsigned int) {
+        if (pcb.priority >= levels.size()) {
+            levels.resize((size_t)pcb.priority + 1);     // size_t, so UINT_MAX + 1 doesn't wrap to 0
+        }
+        levels[pcb.priority].push_back(index);
+        top_level = std::max(top_level, pcb.priority);
+        queued++;
+    }
+
+    /**
+     * @brief Remove and return the oldest process of the highest non-empty priority level
+     */
+    unsigned int pop() {
+        while (levels[top_level].empty()) {
+            top_level--;
+        }
+        unsigned int index = levels[top_level].front();
+        levels[top_level].pop_front();
+        queued--;
+        return index;
+    }
+
+    /**
+     * @brief Visit the queued processes in dispatch order
+     */
+    template <typename Visitor>
+    void for_each(Visitor visit) const {
+        for (size_t level = levels.size(); level-- > 0;) {
+            for (unsigned int index : levels[level]) {
+                visit(index);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Preemption policy that runs every dispatched process to completion.
+ */
+class NonPreemptive {
+public:
+    static constexpr bool preemptive = false;
+
+    /**
+     * @brief The time quantum argument is accepted so all schedulers share one constructor
+     */
+    explicit NonPreemptive(int = 0) {}
+
+    /**
+     * @brief Length of the next CPU slice for a process
+     * @param remaining Remaining burst time of the process
+     */
+    unsigned int slice(unsigned int remaining) const { return remaining; }
+
+    int quantum() const { return 0; }
+};
+
+/**
+ * @brief Preemption policy that preempts a process after a fixed time quantum.
+ */
+class TimeQuantum {
+private:
+    // The maximum time slice given to a process before it goes back to the ready queue
+    unsigned int time_quantum;
+
+public:
+    static constexpr bool preemptive = true;
+
+    /**
+     * @param time_quantum The time slice allocated to each process (default: 10 time units)
+     */
+    explicit TimeQuantum(int time_quantum = 10) : time_quantum(time_quantum) {}
+
+    unsigned int slice(unsigned int remaining) const { return std::min(time_quantum, remaining); }
+
+    int quantum() const { return time_quantum; }
+};
+
+/**
+ * @brief Metrics policy that accumulates the waiting time statistics without printing a trace.
+ */
+class SilentMetrics {
+public:
+    // Statistics for average waiting time calculation
+    double total_waiting_time = 0;
+
+    // Number of completed processes
+    int completed_processes = 0;
+
+    // Number of times a process was given the CPU
+    unsigned long long dispatches = 0;
+
+    /**
+     * @brief Record one dispatch of a process
+     * @param time Simulation time at the end of the slice
+     * @param pcb The dispatched process
+     * @param run Length of the slice
+     * @param remaining Burst time the process still needs after the slice
+     * @param waiting Time the process spent in the ready queue before this slice
+     * @param shows_priority Whether the trace should include the priority
+     * @param shows_remaining Whether a preemptive trace should include the remaining burst time
+     * @param preemptive Whether the scheduler is preemptive
+     */
+    void on_dispatch(int /*time*/, const PCB& /*pcb*/, unsigned int /*run*/, unsigned int remaining, int waiting,
+                     bool /*shows_priority*/, bool /*shows_remaining*/, bool /*preemptive*/) {
+        total_waiting_time += waiting;
+        dispatches++;
+        if (remaining == 0) {
+            completed_processes++;
+        }
+    }
+
+    /**
+     * @brief Write the accumulated statistics to a snapshot
+     */
+    void save(std::ostream& out) const {
+        snapshot_write(out, total_waiting_time);
+        snapshot_write(out, (int32_t)completed_processes);
+        snapshot_write(out, (uint64_t)dispatches);
+    }
+
+    /**
+     * @brief Read the accumulated statistics from a snapshot
+     * @return true if the statistics were read completely
+     */
+    bool restore(std::istream& in) {
+        int32_t completed;
+        uint64_t dispatched;
+        if (!snapshot_read(in, total_waiting_time) || !snapshot_read(in, completed) ||
+            !snapshot_read(in, dispatched)) {
+            return false;
+        }
+        completed_processes = completed;
+        dispatches = dispatched;
+        return true;
+    }
+
+    /**
+     * @brief Print the summary of the simulation
+     * @param name Name of the scheduling algorithm
+     * @param current_time Total simulation time
+     */
+    void print(const char* name, int current_time) const {
+        std::cout << name << " Scheduler Results:" << std::endl;
+        std::cout << "Total time: " << current_time << std::endl;
+        if (completed_processes > 0) {
+            std::cout << "Average waiting time: " << total_waiting_time / completed_processes << std::endl;
+        }
+        std::cout << "Number of completed processes: " << completed_processes << std::endl;
+    }
+};
+
+/**
+ * @brief Metrics policy that also prints one trace line per dispatch, as the original schedulers did.
+ */
+class TraceMetrics : public SilentMetrics {
+public:
+    void on_dispatch(int time, const PCB& pcb, unsigned int run, unsigned int remaining, int waiting,
+                     bool shows_priority, bool shows_remaining, bool preemptive) {
+        SilentMetrics::on_dispatch(time, pcb, run, remaining, waiting, shows_priority, shows_remaining, preemptive);
+
+        std::cout << "Time " << time << ": Process " << pcb.id << " (" << pcb.name << ")";
+        if (shows_priority) {
+            std::cout << " with priority " << pcb.priority;
+        }
+        if (preemptive) {
+            std::cout << " executed for " << run << " units.";
+            if (shows_remaining) {
+                std::cout << " Remaining burst time: " << remaining;
+            }
+            std::cout << std::endl;
+        } else {
+            std::cout << " completed. Burst time: " << run << ", Waiting time: " << waiting << std::endl;
+        }
+    }
+};
+
+#endif //ASSIGN3_SCHEDULER_POLICIES_H
@@ -0,0 +1,20 @@
+/**
+* Assignment 3: CPU Scheduler
+ * @file scheduler_sjf.h
+ * @author Oscar Lopez
+ * @brief This Scheduler class implements the SJF scheduling algorithm.
+ * @version 0.1
+ */
+// The process with the shortest burst time is dispatched first and runs to completion.
+
+#ifndef ASSIGN3_SCHEDULER_SJF_H
+#define ASSIGN3_SCHEDULER_SJF_H
+
+#include "scheduler_basic.h"
+
+/**
+ * @brief This Scheduler class implements the SJF scheduling algorithm.
+ */
+typedef BasicScheduler<ShortestJobQueue, NonPreemptive> SchedulerSJF;
+
+#endif //ASSIGN3_SCHEDULER_SJF_H
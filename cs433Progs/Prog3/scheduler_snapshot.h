@@ -0,0 +1,100 @@
+/**
+* Assignment 3: CPU Scheduler
+ * @file scheduler_snapshot.h
+ * @author Oscar Lopez
+ * @brief Helpers for writing and reading the binary scheduler snapshot format.
+ * @version 0.1
+ */
+// A snapshot is a binary stream of raw values in host byte order (so it is only portable between
+// machines of the same endianness):
+//   magic "SCK1"
+//   current_time (i32)
+//   metrics: total_waiting_time (f64), completed_processes (i32), dispatches (u64)
+//   process count n (u32), then per process:
+//     id, priority, burst_time, arrival_time (u32 each), remaining (u32), ready_since (i32), name (u32 length + bytes)
+//   ready queue length m (u32), then m process indices (u32) in dispatch order
+// The preemption policy (time quantum) is not stored, so a snapshot can be restored into a
+// scheduler with a different queue or quantum to branch a what-if run from the same point.
+
+#ifndef ASSIGN3_SCHEDULER_SNAPSHOT_H
+#define ASSIGN3_SCHEDULER_SNAPSHOT_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+// Identifies a scheduler snapshot stream and its format version
+static const char SNAPSHOT_MAGIC[4] = {'S', 'C', 'K', '1'};
+
+// Upper bound on a count or length read from a stream whose size can't be found out
+static const uint64_t SNAPSHOT_MAX_COUNT = 1u << 24;
+
+// Priority range of a PCB (see pcb.h); anything else in a snapshot is corruption
+static const uint32_t SNAPSHOT_MIN_PRIORITY = 1;
+static const uint32_t SNAPSHOT_MAX_PRIORITY = 50;
+
+// Smallest number of bytes one saved process takes: six u32/i32 fields and an empty name
+static const uint64_t SNAPSHOT_MIN_PROCESS_BYTES = 7 * sizeof(uint32_t);
+
+/**
+ * @brief Number of bytes left in a stream, used to reject corrupted counts before allocating
+ * @return the bytes left, or SNAPSHOT_MAX_COUNT if the stream can't seek
+ */
+inline uint64_t snapshot_bytes_left(std::istream& in) {
+    std::streampos here = in.tellg();
+    if (here == std::streampos(-1)) {
+        return SNAPSHOT_MAX_COUNT;
+    }
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.clear();
+    in.seekg(here);
+    if (end == std::streampos(-1) || end < here) {
+        return SNAPSHOT_MAX_COUNT;
+    }
+    return (uint64_t)(end - here);
+}
+
+/**
+ * @brief Write a fixed-size value as raw bytes
+ */
+template <typename T>
+inline void snapshot_write(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * @brief Read a fixed-size value as raw bytes
+ * @return true if the value was read completely
+ */
+template <typename T>
+inline bool snapshot_read(std::istream& in, T& value) {
+    return (bool)in.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+/**
+ * @brief Write a length-prefixed string
+ */
+inline void snapshot_write_string(std::ostream& out, const std::string& value) {
+    snapshot_write(out, (uint32_t)value.size());
+    out.write(value.data(), value.size());
+}
+
+/**
+ * @brief Read a length-prefixed string
+ * @return true if the string was read completely
+ */
+inline bool snapshot_read_string(std::istream& in, std::string& value) {
+    uint32_t length;
+    if (!snapshot_read(in, length)) {
+        return false;
+    }
+    if (length > snapshot_bytes_left(in)) {
+        return false;
+    }
+    value.resize(length);
+    return length == 0 || (bool)in.read(&value[0], length);
+}
+
+#endif //ASSIGN3_SCHEDULER_SNAPSHOT_H
@@ -0,0 +1,276 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: affinity.h - header file (CPU and NUMA placement of threads)
+// ===========================================================================
+// By default the scheduler puts producer and consumer threads on any CPU and moves them
+// around. A Placement pins them instead:
+//   same         producers and consumers share the CPUs of one NUMA node (one socket), so
+//                items move through that socket's caches
+//   split        producers on the first node, consumers on the second, so every item crosses
+//                the interconnect; with one node the node's CPUs are split in halves
+//   P-CPUS:C-CPUS  explicit lists such as "0,2:1-3" (producers on 0 and 2, consumers on 1..3)
+// Thread i of a kind runs on CPU i of its list, wrapping around. With buffer_on_consumer_node
+// the buffer is built by a thread pinned to the first consumer CPU: Linux places a page on the
+// node of the CPU that first writes it (first touch), and the buffers write all their storage
+// in their constructors.
+#pragma once
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// PURPOSE: parses a CPU list in the kernel's format, e.g. "0-3,8,10-11".
+// PARAMETER: text = the list. *cpus = receives the CPU numbers, in order.
+// RETURN: True = if the list was valid and not empty. False otherwise.
+inline bool parse_cpu_list(const std::string& text, std::vector<int> *cpus) {
+    cpus->clear();
+    std::stringstream in(text);
+    std::string range;
+    while (std::getline(in, range, ',')) {
+        const char *start = range.c_str();
+        char *end;
+        long first = strtol(start, &end, 10);
+        long last = first;
+        if (end == start) {
+            return false;
+        }
+        if (*end == '-') {
+            start = end + 1;
+            last = strtol(start, &end, 10);
+            if (end == start) {
+                return false;
+            }
+        }
+        if (*end != '\0' && *end != '\n') {
+            return false;
+        }
+        if (first < 0 || last < first || last >= CPU_SETSIZE) {
+            return false;
+        }
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus->push_back(cpu);
+        }
+    }
+    return !cpus->empty();
+}
+
+// PURPOSE: lists the CPUs this process may run on.
+// RETURN: the CPU numbers in order.
+inline std::vector<int> allowed_cpus() {
+    cpu_set_t set;
+    std::vector<int> cpus;
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        perror("sched_getaffinity");
+        return cpus;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &set)) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// PURPOSE: reads the NUMA nodes from /sys/devices/system/node, keeping the allowed CPUs only.
+// RETURN: the allowed CPUs of every node that has any; one node with all of them when the
+//         kernel has no NUMA information.
+inline std::vector<std::vector<int>> numa_nodes() {
+    std::vector<int> allowed = allowed_cpus();
+    std::vector<std::vector<int>> nodes;
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string line;
+    std::vector<int> node_ids;
+    if (online && std::getline(online, line)) {
+        parse_cpu_list(line, &node_ids);        // same format as a CPU list
+    }
+    for (int node : node_ids) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::vector<int> cpus, usable;
+        if (file && std::getline(file, line) && parse_cpu_list(line, &cpus)) {
+            for (int cpu : cpus) {
+                for (int ok : allowed) {
+                    if (cpu == ok) {
+                        usable.push_back(cpu);
+                    }
+                }
+            }
+        }
+        if (!usable.empty()) {
+            nodes.push_back(usable);
+        }
+    }
+    if (nodes.empty() && !allowed.empty()) {
+        nodes.push_back(allowed);
+    }
+    return nodes;
+}
+
+// PURPOSE: finds the NUMA node of a CPU.
+// RETURN: the node's index in numa_nodes(), -1 if not found.
+inline int node_of_cpu(int cpu) {
+    std::vector<std::vector<int>> nodes = numa_nodes();
+    for (size_t n = 0; n < nodes.size(); n++) {
+        for (int c : nodes[n]) {
+            if (c == cpu) {
+                return (int)n;
+            }
+        }
+    }
+    return -1;
+}
+
+// Where the threads and the buffer go
+struct Placement {
+    std::vector<int> producer_cpus;     // empty = not pinned
+    std::vector<int> consumer_cpus;
+    bool buffer_on_consumer_node;
+
+    // RETURN: the CPU for thread i of a kind, -1 = not pinned.
+    static int cpu_for(const std::vector<int>& cpus, int i) {
+        return cpus.empty() ? -1 : cpus[i % cpus.size()];
+    }
+    int producer_cpu(int i) const { return cpu_for(producer_cpus, i); }
+    int consumer_cpu(int i) const { return cpu_for(consumer_cpus, i); }
+
+    // RETURN: the CPU the buffer is built on, -1 = the calling thread's.
+    int buffer_cpu() const { return buffer_on_consumer_node ? consumer_cpu(0) : -1; }
+
+    // RETURN: a one-line description, e.g. "producers on CPUs 0,1 (node 0), ...".
+    std::string describe() const {
+        std::ostringstream out;
+        auto list = [&](const char *who, const std::vector<int>& cpus) {
+            out << who;
+            if (cpus.empty()) {
+                out << " unpinned";
+                return;
+            }
+            out << " on CPUs ";
+            for (size_t i = 0; i < cpus.size(); i++) {
+                out << (i ? "," : "") << cpus[i];
+            }
+            out << " (node " << node_of_cpu(cpus[0]) << ")";
+        };
+        list("producers", producer_cpus);
+        list(", consumers", consumer_cpus);
+        if (buffer_cpu() >= 0) {
+            out << ", buffer first touched on node " << node_of_cpu(buffer_cpu());
+        }
+        return out.str();
+    }
+};
+
+// PURPOSE: checks the options once they are all parsed: -m places the buffer on the first
+//          consumer's node, so it needs -a to say where the consumers run.
+// RETURN: True = if consistent. False otherwise, with a message on stderr.
+inline bool check_placement(const Placement& placement) {
+    if (placement.buffer_on_consumer_node && placement.consumer_cpus.empty()) {
+        std::cerr << "placement: -m needs -a to pin the consumers" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// PURPOSE: parses "same", "split" or "P-CPUS:C-CPUS" (see the top of this file).
+// PARAMETER: spec = the text. *placement = receives the CPU lists; buffer_on_consumer_node is
+//            left alone.
+// RETURN: True = if valid and every CPU is one this process may use. False otherwise, with a
+//         message on stderr.
+inline bool parse_placement(const char *spec, Placement *placement) {
+    std::vector<std::vector<int>> nodes = numa_nodes();
+    std::string text(spec);
+    placement->producer_cpus.clear();
+    placement->consumer_cpus.clear();
+    if (nodes.empty()) {
+        std::cerr << "placement: no usable CPUs" << std::endl;
+        return false;
+    }
+    if (text == "same") {
+        placement->producer_cpus = nodes[0];
+        placement->consumer_cpus = nodes[0];
+    } else if (text == "split") {
+        if (nodes.size() > 1) {
+            placement->producer_cpus = nodes[0];
+            placement->consumer_cpus = nodes[1];
+        } else {
+            // one node: split its CPUs in halves (both halves are the same CPU on a 1-CPU box)
+            const std::vector<int>& cpus = nodes[0];
+            size_t half = (cpus.size() + 1) / 2;
+            placement->producer_cpus.assign(cpus.begin(), cpus.begin() + half);
+            placement->consumer_cpus.assign(cpus.begin() + (cpus.size() > 1 ? half : 0), cpus.end());
+            std::cerr << "placement: only one NUMA node, splitting its CPUs instead" << std::endl;
+        }
+    } else {
+        size_t colon = text.find(':');
+        if (colon == std::string::npos || !parse_cpu_list(text.substr(0, colon), &placement->producer_cpus) ||
+            !parse_cpu_list(text.substr(colon + 1), &placement->consumer_cpus)) {
+            std::cerr << "placement: expected same, split or PRODUCER-CPUS:CONSUMER-CPUS" << std::endl;
+            return false;
+        }
+        std::vector<int> allowed = allowed_cpus();
+        for (const std::vector<int> *list : {&placement->producer_cpus, &placement->consumer_cpus}) {
+            for (int cpu : *list) {
+                bool ok = false;
+                for (int a : allowed) {
+                    ok = ok || a == cpu;
+                }
+                if (!ok) {
+                    std::cerr << "placement: CPU " << cpu << " is offline or not allowed" << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// PURPOSE: creates a thread that starts on the given CPU (the creation-time form of
+//          pthread_setaffinity_np, so it never runs anywhere else).
+// PARAMETER: thread = receives the thread. cpu = the CPU, -1 = not pinned. start/arg = as for
+//            pthread_create.
+// RETURN: 0 = if created. An error number from pthread otherwise.
+inline int create_pinned_thread(pthread_t *thread, int cpu, void *(*start)(void *), void *arg) {
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+    }
+    int err = pthread_create(thread, &attr, start, arg);
+    pthread_attr_destroy(&attr);
+    if (err != 0) {
+        std::cerr << "pthread_create on CPU " << cpu << ": " << strerror(err) << std::endl;
+    }
+    return err;
+}
+
+// PURPOSE: runs a function on a thread pinned to the given CPU and waits for it, so the memory
+//          it first writes is placed on that CPU's node.
+// PARAMETER: cpu = the CPU, -1 = just call fn here. fn = the function.
+inline void run_on_cpu(int cpu, const std::function<void()>& fn) {
+    if (cpu < 0) {
+        fn();
+        return;
+    }
+    pthread_t thread;
+    auto call = [](void *param) -> void * {
+        (*(const std::function<void()> *)param)();
+        return NULL;
+    };
+    if (create_pinned_thread(&thread, cpu, call, (void *)&fn) != 0) {
+        fn();
+        return;
+    }
+    pthread_join(thread, NULL);
+}
@@ -0,0 +1,173 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: bench_buffer.cpp - throughput benchmark of the bounded buffers
+// ===========================================================================
+// Build: g++ -O2 -pthread bench_buffer.cpp -o bench_buffer
+// Usage: ./bench_buffer [items] [capacity]
+//
+// Moves `items` (default 2M) from P producers to C consumers through each buffer and prints
+// millions of items per second. "mutex+sem" is the design in main.cpp: a BoundedBuffer behind a
+// mutex and the empty/full semaphores. The lock-free rings yield the CPU while they are full or
+// empty, except "mpmc+futex" which spins, yields, then parks (FutexWait). Every buffer holds
+// `capacity` items (default 1024; the rings round it up to a power of two).
+// A second table moves the items in batches of 1 to 256 with insert_batch/remove_batch.
+// Every run checks that the consumers received exactly the items that were produced.
+#include <pthread.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "blocking_buffer.h"
+#include "ring_buffer.h"
+
+// The buffers under test, all with the same blocking put/take interface (blocking_buffer.h):
+// the mutex + semaphore design of main.cpp, and the rings yielding while full or empty
+typedef SemaphoreBuffer<buffer_item> MutexBuffer;
+typedef BlockingRing<MPMCRing<buffer_item>, YieldWait> MPMCBuffer;
+typedef BlockingRing<SPSCRing<buffer_item>, YieldWait> SPSCBuffer;
+typedef BlockingRing<MPMCRing<buffer_item>, FutexWait> MPMCFutexBuffer;
+
+// ===========================================================================
+// Benchmark driver
+// ===========================================================================
+
+// Work given to one producer or consumer thread
+template <typename Buffer>
+struct Worker {
+    Buffer *buffer;
+    long items;                         // items to insert or remove
+    long first;                         // producers insert first, first + 1, ...
+    std::atomic<long long> *sum;        // consumers add up what they removed
+    size_t batch;                       // items per put_batch/take_batch, 0 for put/take
+};
+
+// PURPOSE: inserts the worker's share of the items.
+// PARAMETER: *param = the Worker.
+template <typename Buffer>
+void *bench_producer(void *param) {
+    Worker<Buffer> *w = (Worker<Buffer> *)param;
+    if (w->batch == 0) {
+        for (long i = 0; i < w->items; i++) {
+            w->buffer->put((buffer_item)(w->first + i));
+        }
+        return NULL;
+    }
+
+    std::vector<buffer_item> items(w->batch);
+    for (long i = 0; i < w->items;) {
+        size_t n = std::min((long)w->batch, w->items - i);
+        for (size_t j = 0; j < n; j++) {
+            items[j] = (buffer_item)(w->first + i + j);
+        }
+        // A partial put leaves the rest for the next round
+        i += w->buffer->put_batch(items.data(), n);
+    }
+    return NULL;
+}
+
+// PURPOSE: removes the worker's share of the items and adds them to the checksum.
+// PARAMETER: *param = the Worker.
+template <typename Buffer>
+void *bench_consumer(void *param) {
+    Worker<Buffer> *w = (Worker<Buffer> *)param;
+    long long sum = 0;
+    if (w->batch == 0) {
+        for (long i = 0; i < w->items; i++) {
+            sum += w->buffer->take();
+        }
+    } else {
+        std::vector<buffer_item> items(w->batch);
+        for (long i = 0; i < w->items;) {
+            size_t n = w->buffer->take_batch(items.data(), std::min((long)w->batch, w->items - i));
+            for (size_t j = 0; j < n; j++) {
+                sum += items[j];
+            }
+            i += n;
+        }
+    }
+    w->sum->fetch_add(sum);
+    return NULL;
+}
+
+// PURPOSE: moves items from producers to consumers through one buffer.
+// PARAMETER: producers/consumers = thread counts. items = total items, a multiple of both counts.
+//            capacity = buffer capacity. batch = items per batch call, 0 to move one at a time.
+// RETURN: items per second, or -1 if the checksum did not match.
+template <typename Buffer>
+double run(int producers, int consumers, long items, size_t capacity, size_t batch = 0) {
+    Buffer buffer(capacity);
+    std::atomic<long long> sum(0);
+    Worker<Buffer> workers[producers + consumers];
+    pthread_t threads[producers + consumers];
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < producers + consumers; i++) {
+        bool producer = i < producers;
+        long share = producer ? items / producers : items / consumers;
+        workers[i] = Worker<Buffer>{&buffer, share, producer ? i * share : 0, &sum, batch};
+        pthread_create(&threads[i], NULL, producer ? bench_producer<Buffer> : bench_consumer<Buffer>,
+                       &workers[i]);
+    }
+    for (int i = 0; i < producers + consumers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    long long expected = (long long)items * (items - 1) / 2;   // 0 + 1 + ... + items - 1
+    return sum.load() == expected ? items / elapsed.count() : -1;
+}
+
+// PURPOSE: prints one result column in millions of items per second.
+void print_rate(double rate) {
+    if (rate < 0) {
+        std::cout << std::setw(12) << "LOST ITEMS";
+    } else {
+        std::cout << std::setw(12) << std::fixed << std::setprecision(2) << rate / 1e6;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    long items = argc > 1 ? atol(argv[1]) : 2000000;
+    size_t capacity = argc > 2 ? atol(argv[2]) : 1024;
+    const int configs[][2] = {{1, 1}, {1, 4}, {4, 1}, {2, 2}, {4, 4}, {8, 8}};
+
+    std::cout << "items: " << items << ", mutex+sem capacity: " << capacity
+              << ", ring capacity: " << round_up_pow2(capacity) << "\n";
+    std::cout << "Mitems/sec  P x C   mutex+sem        mpmc        spsc  mpmc+futex\n";
+
+    for (const auto& config : configs) {
+        int p = config[0], c = config[1];
+        long n = items / (p * c) * (p * c);     // every thread gets an equal share
+        std::cout << std::setw(9) << p << " x " << std::left << std::setw(3) << c << std::right;
+        print_rate(run<MutexBuffer>(p, c, n, capacity));
+        print_rate(run<MPMCBuffer>(p, c, n, capacity));
+        if (p == 1 && c == 1) {
+            print_rate(run<SPSCBuffer>(p, c, n, capacity));
+        } else {
+            std::cout << std::setw(12) << "-";
+        }
+        print_rate(run<MPMCFutexBuffer>(p, c, n, capacity));
+        std::cout << std::endl;
+    }
+
+    // Batch sweep: the consumers' share is not always a multiple of the batch, so the last
+    // take of each consumer is a short one
+    std::cout << "\nMitems/sec  batch  mutex+sem 1x1  mutex+sem 4x4   spsc 1x1\n";
+    for (size_t batch = 1; batch <= 256; batch *= 4) {
+        long n = items / 16 * 16;
+        std::cout << std::setw(17) << batch << "  ";
+        print_rate(run<MutexBuffer>(1, 1, n, capacity, batch));
+        std::cout << "   ";
+        print_rate(run<MutexBuffer>(4, 4, n, capacity, batch));
+        print_rate(run<SPSCBuffer>(1, 1, n, capacity, batch));
+        std::cout << std::endl;
+    }
+    return 0;
+}
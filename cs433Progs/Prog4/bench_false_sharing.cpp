@@ -0,0 +1,255 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: bench_false_sharing.cpp - cache-line layout of the SPSC ring indices
+// ===========================================================================
+// Build: g++ -O2 -pthread bench_false_sharing.cpp -o bench_false_sharing
+// Usage: ./bench_false_sharing [items] [capacity] [producer_cpu] [consumer_cpu]
+//
+// One producer moves `items` (default 20M) to one consumer through three layouts of the same
+// Lamport ring, with the producer and consumer pinned to the given CPUs (default 0 and 1, or
+// both 0 on a single-CPU machine):
+//   packed   front, back and a shared count on one cache line; both sides update the count
+//            with an atomic add, like the original buffer.cpp
+//   padded   front and back on their own lines, no count, but every operation reads the
+//            other side's index
+//   cached   SPSCRing from ring_buffer.h: padded, and each side reads the other's index only
+//            when the ring looks full or empty
+// Besides items per second it prints hardware cache misses per item (perf_event_open, counted
+// over both threads); "n/a" where the kernel or the container doesn't allow perf events.
+// False sharing only shows when the threads run on different cores: pinned to the same CPU
+// they share one cache and the three layouts differ by the instructions they execute.
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include "ring_buffer.h"
+
+// ===========================================================================
+// Comparison layouts. Same interface as SPSCRing: 0 on success, -1 when full/empty.
+// ===========================================================================
+
+// The layout of the original buffer: both indices and the count share a line, and the count
+// is written by both sides, so every operation pulls the line away from the other core.
+template <typename T>
+class PackedCountRing {
+public:
+    explicit PackedCountRing(size_t capacity)
+        : mask(round_up_pow2(capacity) - 1), items(new T[mask + 1]), front(0), back(0), count(0)
+    {
+    }
+
+    int insert_item(const T& item) {
+        if (count.load(std::memory_order_acquire) > mask) {
+            return -1;
+        }
+        size_t b = back.load(std::memory_order_relaxed);
+        items[b & mask] = item;
+        back.store(b + 1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_release);
+        return 0;
+    }
+
+    int remove_item(T *item) {
+        if (count.load(std::memory_order_acquire) == 0) {
+            return -1;
+        }
+        size_t f = front.load(std::memory_order_relaxed);
+        *item = items[f & mask];
+        front.store(f + 1, std::memory_order_relaxed);
+        count.fetch_sub(1, std::memory_order_release);
+        return 0;
+    }
+
+private:
+    const size_t mask;
+    std::unique_ptr<T[]> items;
+    std::atomic<size_t> front;
+    std::atomic<size_t> back;
+    std::atomic<size_t> count;
+};
+
+// Indices on separate lines but no cached copies: the line holding the other side's index is
+// still read on every operation, so it moves each time that side writes it.
+template <typename T>
+class PaddedRing {
+public:
+    explicit PaddedRing(size_t capacity)
+        : mask(round_up_pow2(capacity) - 1), items(new T[mask + 1]), back(0), front(0)
+    {
+    }
+
+    int insert_item(const T& item) {
+        size_t b = back.load(std::memory_order_relaxed);
+        if (b - front.load(std::memory_order_acquire) > mask) {
+            return -1;
+        }
+        items[b & mask] = item;
+        back.store(b + 1, std::memory_order_release);
+        return 0;
+    }
+
+    int remove_item(T *item) {
+        size_t f = front.load(std::memory_order_relaxed);
+        if (f == back.load(std::memory_order_acquire)) {
+            return -1;
+        }
+        *item = items[f & mask];
+        front.store(f + 1, std::memory_order_release);
+        return 0;
+    }
+
+private:
+    const size_t mask;
+    std::unique_ptr<T[]> items;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> back;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> front;
+};
+
+// ===========================================================================
+// Benchmark driver
+// ===========================================================================
+
+// Shared state of one run
+template <typename Ring>
+struct Run {
+    Ring *ring;
+    long items;
+    int cpu[2];                 // producer's and consumer's CPU
+    long sum;                   // consumer's checksum of the received items
+};
+
+// PURPOSE: pins the calling thread to one CPU.
+// PARAMETER: cpu = the CPU number.
+// RETURN: True = if the affinity was set. False otherwise.
+bool pin_to_cpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (err != 0) {
+        std::cerr << "pthread_setaffinity_np(cpu " << cpu << "): " << strerror(err) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// PURPOSE: inserts 1..items, yielding while the ring is full.
+// PARAMETER: *param = the Run.
+template <typename Ring>
+void *fs_producer(void *param) {
+    Run<Ring> *run = (Run<Ring> *)param;
+    pin_to_cpu(run->cpu[0]);
+    for (long i = 1; i <= run->items; i++) {
+        while (run->ring->insert_item((buffer_item)i) != 0) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+// PURPOSE: removes every item, yielding while the ring is empty, and sums them.
+// PARAMETER: *param = the Run.
+template <typename Ring>
+void *fs_consumer(void *param) {
+    Run<Ring> *run = (Run<Ring> *)param;
+    pin_to_cpu(run->cpu[1]);
+    long sum = 0;
+    buffer_item item = 0;
+    for (long i = 0; i < run->items; i++) {
+        while (run->ring->remove_item(&item) != 0) {
+            sched_yield();
+        }
+        sum += item;
+    }
+    run->sum = sum;
+    return NULL;
+}
+
+// PURPOSE: opens a hardware cache-miss counter for this process and the threads it creates later.
+// RETURN: the counter's file descriptor, -1 if perf events are unavailable.
+int open_cache_miss_counter() {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.inherit = 1;           // count the producer and consumer threads too
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+// PURPOSE: moves items through one ring with pinned threads and prints the rate and misses.
+// PARAMETER: name = layout name. items = items to move. capacity = ring capacity. cpu = CPUs.
+template <typename Ring>
+void measure(const char *name, long items, size_t capacity, const int cpu[2]) {
+    Ring ring(capacity);
+    Run<Ring> run{&ring, items, {cpu[0], cpu[1]}, 0};
+    pthread_t producer, consumer;
+
+    int counter = open_cache_miss_counter();
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    auto start = std::chrono::steady_clock::now();
+    pthread_create(&consumer, NULL, fs_consumer<Ring>, &run);
+    pthread_create(&producer, NULL, fs_producer<Ring>, &run);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long long misses = -1;
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter, &misses, sizeof(misses)) != sizeof(misses)) {
+            misses = -1;
+        }
+        close(counter);
+    }
+
+    std::cout << std::left << std::setw(8) << name << std::right << std::fixed
+              << std::setw(12) << std::setprecision(2) << items / seconds / 1e6;
+    if (misses >= 0) {
+        std::cout << std::setw(16) << std::setprecision(3) << (double)misses / items;
+    } else {
+        std::cout << std::setw(16) << "n/a";
+    }
+    if (run.sum != items * (items + 1) / 2) {
+        std::cout << "  CHECKSUM MISMATCH";
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    long items = argc > 1 ? atol(argv[1]) : 20000000;
+    size_t capacity = argc > 2 ? atol(argv[2]) : 1024;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int cpu[2];
+    cpu[0] = argc > 3 ? atoi(argv[3]) : 0;
+    cpu[1] = argc > 4 ? atoi(argv[4]) : (cpus > 1 ? 1 : 0);
+
+    std::cout << "items: " << items << ", capacity: " << capacity << ", producer on CPU " << cpu[0]
+              << ", consumer on CPU " << cpu[1] << " (" << cpus << " online)\n";
+    if (cpu[0] == cpu[1]) {
+        std::cout << "both threads on one CPU: no cross-core traffic, false sharing can't show\n";
+    }
+    std::cout << "layout  Mitems/sec  misses/item\n";
+    measure<PackedCountRing<buffer_item>>("packed", items, capacity, cpu);
+    measure<PaddedRing<buffer_item>>("padded", items, capacity, cpu);
+    measure<SPSCRing<buffer_item>>("cached", items, capacity, cpu);
+    return 0;
+}
@@ -0,0 +1,163 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: bench_priority.cpp - control messages next to bulk data
+// ===========================================================================
+// Build: g++ -O2 -pthread bench_priority.cpp -o bench_priority
+// Usage: ./bench_priority [control_messages] [capacity]
+//
+// A control producer sends `control_messages` (default 2000) class-0 items next to class-3 bulk
+// data, and one consumer spends 2 us on every item. In a plain FIFO ring (MPMCRing) a control
+// message waits behind everything already queued; in PriorityRing it overtakes the bulk data.
+// Two scenarios:
+//   trickle  a control message every 200 us while a bulk producer keeps the buffer full: how
+//            long control messages take
+//   flood    a backlog of control and bulk messages, queued alternately before the consumer
+//            starts (the buffer is sized to hold it all): with both classes waiting on every
+//            removal, bulk data must still get through (starvation)
+// Latencies are put-to-take in microseconds; "bulk share" is the fraction of removed items that
+// were bulk before the last control message was removed. In the flood half of the backlog is
+// bulk, so a fifo gives bulk 0.5 and the priority ring only its starvation-limit share, 1 in 17.
+// (Producers racing a running consumer can't show this: whatever is sent gets removed, so the
+// share just follows the arrival mix.)
+#include <pthread.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "blocking_buffer.h"
+#include "priority_buffer.h"
+#include "workload.h"
+
+#define CONTROL 0               // priority class of control messages
+#define BULK 3                  // priority class of bulk data
+
+typedef Prioritized<stamp> Message;     // the send time, tagged with its class
+
+// Shared state of one run
+template <typename Buffer>
+struct Run {
+    Buffer *buffer;
+    long control_messages;
+    long gap_us;                        // time between two control messages; 0 = flood
+    std::atomic<bool> control_done;
+    std::vector<stamp> control_latency; // filled by the consumer
+    std::vector<stamp> bulk_latency;
+    long bulk_while_control;            // bulk items removed before the last control message
+    long control_removed;
+};
+
+template <typename Buffer>
+void *control_producer(void *param) {
+    Run<Buffer> *run = (Run<Buffer> *)param;
+    ThinkTime gap{run->gap_us > 0 ? THINK_FIXED : THINK_ZERO, (double)run->gap_us};
+    Rng rng(1);
+    for (long i = 0; i < run->control_messages; i++) {
+        gap.think(rng);
+        run->buffer->put(Message{CONTROL, now_ns()});
+        if (run->gap_us == 0) {
+            run->buffer->put(Message{BULK, now_ns()});      // the flood backlog alternates
+        }
+    }
+    run->control_done = true;
+    return NULL;
+}
+
+template <typename Buffer>
+void *bulk_producer(void *param) {
+    Run<Buffer> *run = (Run<Buffer> *)param;
+    while (!run->control_done) {
+        run->buffer->put(Message{BULK, now_ns()});
+    }
+    return NULL;
+}
+
+// PURPOSE: takes every item until the buffer is closed, spending 2 us on each.
+template <typename Buffer>
+void *priority_consumer(void *param) {
+    Run<Buffer> *run = (Run<Buffer> *)param;
+    Message message;
+    while (run->buffer->take_batch(&message, 1) == 1) {
+        stamp latency = now_ns() - message.item;
+        if (message.priority == CONTROL) {
+            run->control_latency.push_back(latency);
+            run->control_removed++;
+        } else {
+            run->bulk_latency.push_back(latency);
+            if (run->control_removed < run->control_messages) {
+                run->bulk_while_control++;
+            }
+        }
+        stamp until = now_ns() + 2000;
+        while (now_ns() < until) {
+        }
+    }
+    return NULL;
+}
+
+// PURPOSE: runs one scenario over one buffer and prints its line.
+template <typename Buffer>
+void measure(const char *scenario, const char *name, long control_messages, size_t capacity, long gap_us) {
+    Buffer buffer(capacity);
+    Run<Buffer> run;
+    run.buffer = &buffer;
+    run.control_messages = control_messages;
+    run.gap_us = gap_us;
+    run.control_done = false;
+    run.bulk_while_control = 0;
+    run.control_removed = 0;
+
+    pthread_t consumer, control, bulk;
+    if (gap_us > 0) {
+        pthread_create(&consumer, NULL, priority_consumer<Buffer>, &run);
+        pthread_create(&bulk, NULL, bulk_producer<Buffer>, &run);
+        pthread_create(&control, NULL, control_producer<Buffer>, &run);
+        pthread_join(control, NULL);
+        pthread_join(bulk, NULL);
+    } else {
+        // queue the whole backlog first, then let the consumer choose from it
+        pthread_create(&control, NULL, control_producer<Buffer>, &run);
+        pthread_join(control, NULL);
+        pthread_create(&consumer, NULL, priority_consumer<Buffer>, &run);
+    }
+    buffer.close();
+    pthread_join(consumer, NULL);
+
+    auto percentile = [](std::vector<stamp>& lat, double p) {
+        if (lat.empty()) {
+            return 0.0;
+        }
+        std::sort(lat.begin(), lat.end());
+        return lat[(size_t)(p * (lat.size() - 1))] / 1000.0;
+    };
+    long removed = run.bulk_while_control + run.control_removed;
+    double share = removed > 0 ? (double)run.bulk_while_control / removed : 0.0;
+    std::cout << std::left << std::setw(9) << scenario << std::setw(10) << name << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << percentile(run.control_latency, 0.50)
+              << std::setw(10) << percentile(run.control_latency, 0.99)
+              << std::setw(12) << percentile(run.bulk_latency, 0.50)
+              << std::setw(12) << percentile(run.bulk_latency, 1.0)
+              << std::setw(10) << std::setprecision(3) << share << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    long control_messages = argc > 1 ? atol(argv[1]) : 2000;
+    size_t capacity = argc > 2 ? atol(argv[2]) : 256;
+    typedef BlockingRing<MPMCRing<Message>, FutexWait> FifoBuffer;
+    typedef BlockingRing<PriorityRing<stamp>, FutexWait> PriorityBuffer;
+
+    std::cout << "control messages: " << control_messages << ", capacity: " << capacity
+              << " (per class for priority; the flood sizes the buffer to its backlog)\n";
+    std::cout << "scenario buffer    ctl_p50   ctl_p99    bulk_p50    bulk_max  bulk share\n";
+    measure<FifoBuffer>("trickle", "fifo", control_messages, capacity, 200);
+    measure<PriorityBuffer>("trickle", "priority", control_messages, capacity, 200);
+    measure<FifoBuffer>("flood", "fifo", control_messages, 2 * control_messages, 0);
+    measure<PriorityBuffer>("flood", "priority", control_messages, control_messages, 0);
+    return 0;
+}
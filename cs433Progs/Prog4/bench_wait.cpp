@@ -0,0 +1,124 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: bench_wait.cpp - handoff latency and CPU cost of the wait strategies
+// ===========================================================================
+// Build: g++ -O2 -pthread bench_wait.cpp -o bench_wait
+// Usage: ./bench_wait [items] [capacity]
+//
+// One producer sends `items` (default 20000) timestamps to one consumer, one every `gap`
+// microseconds, and the consumer records how long each one took to arrive. With a gap the
+// consumer is usually waiting, so this measures how fast a waiting thread wakes up; a gap of 0
+// keeps the buffer busy. CPU is the process' user + system time over the wall time (100% is
+// one core busy), i.e. what the waiting costs.
+//   sem       the mutex + semaphore design of main.cpp
+//   yield     MPMCRing, sched_yield until it can proceed
+//   futex     MPMCRing, park on a futex right away
+//   adaptive  MPMCRing, spin, then yield, then park on a futex
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "blocking_buffer.h"
+#include "ring_buffer.h"
+#include "workload.h"
+
+// PURPOSE: reads the CPU time used by the whole process.
+// RETURN: user + system seconds.
+double cpu_seconds() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// Shared state of one run
+template <typename Buffer>
+struct Run {
+    Buffer *buffer;
+    long items;
+    long gap_ns;                        // time between two sends
+    std::vector<stamp> latencies;       // filled by the consumer
+};
+
+// PURPOSE: sends a timestamp every gap_ns, sleeping until each send time.
+// PARAMETER: *param = the Run.
+template <typename Buffer>
+void *wait_producer(void *param) {
+    Run<Buffer> *run = (Run<Buffer> *)param;
+    stamp next = now_ns();
+    for (long i = 0; i < run->items; i++) {
+        if (run->gap_ns > 0) {
+            next += run->gap_ns;
+            struct timespec ts = {(time_t)(next / 1000000000LL), (long)(next % 1000000000LL)};
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+        }
+        run->buffer->put(now_ns());
+    }
+    return NULL;
+}
+
+// PURPOSE: receives every timestamp and records its latency.
+// PARAMETER: *param = the Run.
+template <typename Buffer>
+void *wait_consumer(void *param) {
+    Run<Buffer> *run = (Run<Buffer> *)param;
+    for (long i = 0; i < run->items; i++) {
+        stamp sent = run->buffer->take();
+        run->latencies.push_back(now_ns() - sent);
+    }
+    return NULL;
+}
+
+// PURPOSE: runs one producer and one consumer over a buffer and prints latency percentiles.
+// PARAMETER: name = strategy name. buffer = the buffer. items = items to send. gap_us = pacing.
+template <typename Buffer>
+void measure(const char *name, Buffer& buffer, long items, long gap_us) {
+    Run<Buffer> run{&buffer, items, gap_us * 1000, {}};
+    run.latencies.reserve(items);
+    pthread_t producer, consumer;
+
+    double cpu_start = cpu_seconds();
+    stamp start = now_ns();
+    pthread_create(&consumer, NULL, wait_consumer<Buffer>, &run);
+    pthread_create(&producer, NULL, wait_producer<Buffer>, &run);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+    double wall = (now_ns() - start) / 1e9;
+    double cpu = cpu_seconds() - cpu_start;
+
+    std::vector<stamp>& lat = run.latencies;
+    std::sort(lat.begin(), lat.end());
+    auto percentile = [&](double p) { return lat[(size_t)(p * (lat.size() - 1))] / 1000.0; };
+    std::cout << std::setw(6) << gap_us << "  " << std::left << std::setw(9) << name << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << percentile(0.50) << std::setw(10) << percentile(0.99)
+              << std::setw(10) << percentile(0.999) << std::setw(8) << 100 * cpu / wall << "%"
+              << std::setw(11) << std::setprecision(0) << items / wall << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    long items = argc > 1 ? atol(argv[1]) : 20000;
+    size_t capacity = argc > 2 ? atol(argv[2]) : 1024;
+    const long gaps_us[] = {0, 10, 100};
+
+    std::cout << "items: " << items << ", capacity: " << capacity << "\n";
+    std::cout << "gap_us  strategy    p50_us    p99_us   p999_us     CPU  items/sec\n";
+    for (long gap : gaps_us) {
+        SemaphoreBuffer<stamp> sem(capacity);
+        BlockingRing<MPMCRing<stamp>, YieldWait> yield(capacity);
+        BlockingRing<MPMCRing<stamp>, FutexWait> futex(capacity, 0, 0);
+        BlockingRing<MPMCRing<stamp>, FutexWait> adaptive(capacity);
+        measure("sem", sem, items, gap);
+        measure("yield", yield, items, gap);
+        measure("futex", futex, items, gap);
+        measure("adaptive", adaptive, items, gap);
+    }
+    return 0;
+}
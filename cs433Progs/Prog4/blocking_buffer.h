@@ -0,0 +1,290 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: blocking_buffer.h - header file (wait strategies and blocking buffers)
+// ===========================================================================
+// The rings in ring_buffer.h never block. BlockingRing makes put/take wait for room or
+// items with a wait strategy:
+//   - YieldWait gives up the CPU and retries until the operation succeeds
+//   - FutexWait spins briefly, then yields a few times, then parks on a futex; a
+//     notify only makes the wake-up system call when some thread is parked
+// SemaphoreBuffer is the mutex + empty/full semaphore design of main.cpp as a class,
+// kept for comparison.
+#pragma once
+#include <pthread.h>
+#include <semaphore.h>
+#include <sched.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include "buffer.h"
+
+// PURPOSE: tells the CPU this is a spin loop (saves power, frees the sibling hyperthread).
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// ===========================================================================
+// Wait strategies. wait(ready) returns once ready() returns true; ready() is the
+// non-blocking operation itself, so a successful check has already done the work.
+// notify(n) is called after an operation that may let up to n waiters proceed.
+// ===========================================================================
+
+// Busy waiting that yields the CPU between attempts; never sleeps in the kernel.
+class YieldWait {
+public:
+    explicit YieldWait(int = 0, int = 0) {}
+
+    template <typename Ready>
+    void wait(Ready ready) {
+        while (!ready()) {
+            sched_yield();
+        }
+    }
+
+    void notify(int) {}
+};
+
+// Spin, then yield, then park on a futex.
+class FutexWait {
+public:
+    // PARAMETER: spins = failed checks with a pause in between before yielding; ignored on a
+    //                     single CPU, where the other thread can't make progress while we spin.
+    //            yields = failed checks with a sched_yield in between before parking.
+    explicit FutexWait(int spins = 100, int yields = 10)
+        : spin_limit(sysconf(_SC_NPROCESSORS_ONLN) > 1 ? spins : 0), yield_limit(yields),
+          epoch(0), waiters(0)
+    {
+    }
+
+    template <typename Ready>
+    void wait(Ready ready) {
+        for (int i = 0; i < spin_limit; i++) {
+            if (ready()) {
+                return;
+            }
+            cpu_relax();
+        }
+        for (int i = 0; i < yield_limit; i++) {
+            if (ready()) {
+                return;
+            }
+            sched_yield();
+        }
+
+        while (true) {
+            // Register before the last check: a notifier that changes the buffer after the
+            // check must see the waiter and bump the epoch, which makes FUTEX_WAIT return
+            uint32_t seen = epoch.load(std::memory_order_acquire);
+            waiters.fetch_add(1, std::memory_order_seq_cst);
+            if (ready()) {
+                waiters.fetch_sub(1, std::memory_order_relaxed);
+                return;
+            }
+            syscall(SYS_futex, &epoch, FUTEX_WAIT_PRIVATE, seen, NULL, NULL, 0);
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+            if (ready()) {
+                return;
+            }
+        }
+    }
+
+    void notify(int n) {
+        // Pairs with the fetch_add in wait(): either the waiter's check sees the change,
+        // or this load sees the waiter
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) == 0) {
+            return;     // nobody parked: no system call
+        }
+        epoch.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, &epoch, FUTEX_WAKE_PRIVATE, n, NULL, NULL, 0);
+    }
+
+private:
+    const int spin_limit;
+    const int yield_limit;
+    std::atomic<uint32_t> epoch;        // the futex word; changes on every wake-up
+    std::atomic<int> waiters;           // threads parked or about to park
+};
+
+// ===========================================================================
+// A lock-free ring (MPMCRing or SPSCRing) with blocking put/take.
+// ===========================================================================
+template <typename Ring, typename Wait = FutexWait>
+class BlockingRing {
+public:
+    typedef typename Ring::value_type T;
+
+    // PARAMETER: capacity = ring capacity. spins/yields = wait strategy limits.
+    explicit BlockingRing(size_t capacity, int spins = 100, int yields = 10)
+        : buffer(capacity), not_full(spins, yields), not_empty(spins, yields), closed(false), stopped(false)
+    {
+    }
+
+    // PURPOSE: inserts an item, waiting while the ring is full.
+    void put(const T& item) {
+        not_full.wait([&] { return buffer.insert_item(item) == 0; });
+        not_empty.notify(1);
+    }
+
+    // PURPOSE: removes an item, waiting while the ring is empty.
+    T take() {
+        T item;
+        not_empty.wait([&] { return buffer.remove_item(&item) == 0; });
+        not_full.notify(1);
+        return item;
+    }
+
+    // PURPOSE: inserts an item if there is room, without waiting.
+    // RETURN: True = if the item was inserted. False = if the ring was full.
+    bool try_put(const T& item) {
+        if (buffer.insert_item(item) != 0) {
+            return false;
+        }
+        not_empty.notify(1);
+        return true;
+    }
+
+    // PURPOSE: removes an item if there is one, without waiting.
+    // RETURN: True = if an item was removed. False = if the ring was empty.
+    bool try_take(T *item) {
+        if (buffer.remove_item(item) != 0) {
+            return false;
+        }
+        not_full.notify(1);
+        return true;
+    }
+
+    // PURPOSE: inserts up to n items, waiting until at least one fits or producers are stopped.
+    // RETURN: the number inserted; 0 only once stop_producers() was called and the ring is full.
+    size_t put_batch(const T *src, size_t n) {
+        size_t count = 0;
+        not_full.wait([&] {
+            return (count = buffer.insert_batch(src, n)) > 0 || stopped.load(std::memory_order_acquire);
+        });
+        not_empty.notify(count > INT_MAX ? INT_MAX : (int)count);
+        return count;
+    }
+
+    // PURPOSE: removes up to max items, waiting until there is at least one or the ring is closed.
+    // RETURN: the number removed; 0 only once the ring is closed and empty.
+    size_t take_batch(T *dst, size_t max) {
+        size_t count = 0;
+        not_empty.wait([&] {
+            return (count = buffer.remove_batch(dst, max)) > 0 || closed.load(std::memory_order_acquire);
+        });
+        not_full.notify(count > INT_MAX ? INT_MAX : (int)count);
+        return count;
+    }
+
+    // PURPOSE: tells consumers no more items are coming: take_batch stops waiting and returns 0
+    //          once the ring is empty. Call it after every producer has finished.
+    void close() {
+        closed.store(true, std::memory_order_release);
+        not_empty.notify(INT_MAX);
+    }
+
+    // PURPOSE: tells producers to stop: put_batch stops waiting for room and returns 0 if the
+    //          ring is full, so a producer blocked on a ring nobody empties can still exit.
+    void stop_producers() {
+        stopped.store(true, std::memory_order_release);
+        not_full.notify(INT_MAX);
+    }
+
+    // RETURN: the underlying ring.
+    Ring& ring() { return buffer; }
+
+private:
+    Ring buffer;
+    Wait not_full;      // producers wait here
+    Wait not_empty;     // consumers wait here
+    std::atomic<bool> closed;
+    std::atomic<bool> stopped;
+};
+
+// ===========================================================================
+// The original design: a BoundedBuffer behind a mutex, with the empty/full
+// semaphores counting free slots and items.
+// ===========================================================================
+template <typename T>
+class SemaphoreBuffer {
+public:
+    explicit SemaphoreBuffer(size_t capacity) : buffer(capacity) {
+        pthread_mutex_init(&mutex, NULL);
+        sem_init(&empty, 0, capacity);
+        sem_init(&full, 0, 0);
+    }
+
+    ~SemaphoreBuffer() {
+        pthread_mutex_destroy(&mutex);
+        sem_destroy(&empty);
+        sem_destroy(&full);
+    }
+
+    void put(const T& item) {
+        sem_wait(&empty);
+        pthread_mutex_lock(&mutex);
+        buffer.insert_item(item);
+        pthread_mutex_unlock(&mutex);
+        sem_post(&full);
+    }
+
+    T take() {
+        T item = T();
+        sem_wait(&full);
+        pthread_mutex_lock(&mutex);
+        buffer.remove_item(&item);
+        pthread_mutex_unlock(&mutex);
+        sem_post(&empty);
+        return item;
+    }
+
+    // PURPOSE: claims one slot blocking and more without blocking, then fills them under one lock.
+    // RETURN: the number inserted.
+    size_t put_batch(const T *src, size_t n) {
+        sem_wait(&empty);
+        size_t claimed = 1;
+        while (claimed < n && sem_trywait(&empty) == 0) {
+            claimed++;
+        }
+        pthread_mutex_lock(&mutex);
+        buffer.insert_batch(src, claimed);
+        pthread_mutex_unlock(&mutex);
+        for (size_t i = 0; i < claimed; i++) {
+            sem_post(&full);
+        }
+        return claimed;
+    }
+
+    // PURPOSE: takes one item blocking and more without blocking, under one lock.
+    // RETURN: the number removed.
+    size_t take_batch(T *dst, size_t max) {
+        sem_wait(&full);
+        size_t claimed = 1;
+        while (claimed < max && sem_trywait(&full) == 0) {
+            claimed++;
+        }
+        pthread_mutex_lock(&mutex);
+        buffer.remove_batch(dst, claimed);
+        pthread_mutex_unlock(&mutex);
+        for (size_t i = 0; i < claimed; i++) {
+            sem_post(&empty);
+        }
+        return claimed;
+    }
+
+private:
+    BoundedBuffer<T> buffer;
+    pthread_mutex_t mutex;
+    sem_t full;
+    sem_t empty;
+};
@@ -2,16 +2,174 @@
 // Name: Oscar Lopez
 // Date: 04/10/25
 // Course: CS433 - Operating Systems Section 1
-// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem 
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
 // File type: buffer.h - header file
 // ===========================================================================
 #pragma once
 #include <iostream>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 
 typedef int buffer_item;        // buffer_item defined as an int.
 #define BUFFER_SIZE 5           // size of the buffer
 
-// Function declarations
+// PURPOSE: rounds a capacity up to a power of two so positions wrap with a mask instead of %.
+// PARAMETER: n = the requested capacity.
+// RETURN: the smallest power of two >= n (at least 2).
+constexpr size_t round_up_pow2(size_t n) {
+    size_t size = 2;
+    while (size < n) {
+        size <<= 1;
+    }
+    return size;
+}
+
+// PURPOSE: copies n items; plain memcpy for trivially copyable items such as buffer_item.
+// PARAMETER: dst = destination. src = source. n = number of items.
+template <typename T>
+inline void copy_items(T *dst, const T *src, size_t n) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+        if (n > 0) {
+            memcpy(dst, src, n * sizeof(T));
+        }
+    } else {
+        std::copy(src, src + n, dst);
+    }
+}
+
+// ===========================================================================
+// A circular buffer of `T` items. Like the original file-global buffer it is not
+// synchronized; callers hold their own lock. Each instance is independent.
+// Capacity > 0 fixes the capacity at compile time; Capacity = 0 takes it from the
+// constructor. Storage is rounded up to a power of two so positions wrap with a
+// mask, but the buffer still holds exactly `capacity` items.
+// Positions run freely (back - front is the item count), so there is no count.
+// ===========================================================================
+template <typename T, size_t Capacity = 0>
+class BoundedBuffer {
+public:
+    typedef T value_type;
+
+    // PURPOSE: creates an empty buffer.
+    // PARAMETER: capacity = number of items it holds; ignored when Capacity is fixed.
+    explicit BoundedBuffer(size_t capacity = Capacity)
+        : limit(Capacity ? Capacity : capacity), runtime_mask(round_up_pow2(limit) - 1),
+          items(new T[mask() + 1]()), front(0), back(0)
+    {
+    }
+
+    // PURPOSE: checks if the buffer is full.
+    // RETURN: True = if it holds capacity() items. False otherwise.
+    bool isFull() const {
+        return back - front == limit;
+    }
+
+    // PURPOSE: checks if the buffer is empty.
+    // RETURN: True = if it holds no items. False otherwise.
+    bool isEmpty() const {
+        return back == front;
+    }
+
+    // PURPOSE: inserts an item at the back of the buffer.
+    // PARAMETER: item = the item to insert into buffer.
+    // RETURN: 0 = if insert was successful. -1 = if the buffer is full.
+    int insert_item(const T& item) {
+        if (isFull()) {
+            return -1;
+        }
+        items[back & mask()] = item;
+        back++;
+        return 0;
+    }
+
+    // PURPOSE: removes the item at the front of the buffer.
+    // PARAMETER: *item = the item removed from the buffer.
+    // RETURN: 0 = if remove was successful. -1 = if the buffer is empty.
+    int remove_item(T *item) {
+        if (isEmpty()) {
+            return -1;
+        }
+        *item = items[front & mask()];
+        front++;
+        return 0;
+    }
+
+    // PURPOSE: inserts up to n items at the back of the buffer. The free range is claimed once
+    //          and filled with one copy, or two when it wraps around the end of the storage.
+    // PARAMETER: src = the items to insert. n = how many.
+    // RETURN: the number of items inserted, fewer than n when the buffer fills up.
+    size_t insert_batch(const T *src, size_t n) {
+        size_t count = std::min(n, limit - size());
+        size_t start = back & mask();
+        size_t first = std::min(count, mask() + 1 - start);    // part before the wrap
+        copy_items(&items[start], src, first);
+        copy_items(&items[0], src + first, count - first);
+        back += count;
+        return count;
+    }
+
+    // PURPOSE: removes up to max items from the front of the buffer, in one or two copies.
+    // PARAMETER: dst = receives the removed items, front first. max = room in dst.
+    // RETURN: the number of items removed, 0 if the buffer is empty.
+    size_t remove_batch(T *dst, size_t max) {
+        size_t count = std::min(max, size());
+        size_t start = front & mask();
+        size_t first = std::min(count, mask() + 1 - start);
+        copy_items(dst, &items[start], first);
+        copy_items(dst + first, &items[0], count - first);
+        front += count;
+        return count;
+    }
+
+    // PURPOSE: displays the current items in the buffer, front first.
+    void display() const {
+        std::cout << "[";
+        if (isEmpty()) {
+            std::cout << "empty";
+        }
+        for (size_t pos = front; pos != back; pos++) {
+            std::cout << items[pos & mask()];
+            if (pos + 1 != back) {
+                std::cout << ", ";      // Add comma if not the last element
+            }
+        }
+        std::cout << "]" << std::endl;
+    }
+
+    // PURPOSE: copies up to max items from the front without removing them.
+    // PARAMETER: dst = receives the items, front first. max = room in dst.
+    // RETURN: the number of items copied.
+    size_t snapshot(T *dst, size_t max) const {
+        size_t count = std::min(max, size());
+        size_t start = front & mask();
+        size_t first = std::min(count, mask() + 1 - start);
+        copy_items(dst, &items[start], first);
+        copy_items(dst + first, &items[0], count - first);
+        return count;
+    }
+
+    // RETURN: the number of items in the buffer.
+    size_t size() const { return back - front; }
+
+    // RETURN: the number of items the buffer holds when full.
+    size_t capacity() const { return limit; }
+
+private:
+    // PURPOSE: mask applied to positions; a constant the compiler folds when Capacity is fixed.
+    size_t mask() const { return Capacity ? round_up_pow2(Capacity) - 1 : runtime_mask; }
+
+    const size_t limit;                 // capacity in items
+    const size_t runtime_mask;          // storage size - 1
+    std::unique_ptr<T[]> items;         // the circular storage, written once by the constructor
+                                        // so its pages land on the constructing thread's node
+    size_t front;                       // position of the front item.
+    size_t back;                        // position after the back item.
+};
+
+// Function declarations, working on the global buffer of BUFFER_SIZE buffer_items
 void display();
 bool isFull();
 bool isEmpty();
@@ -0,0 +1,206 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: event_log.h - header file (asynchronous event log)
+// ===========================================================================
+// Producers and consumers used to print each operation and the whole buffer with std::cout
+// while holding the mutex, so every buffer operation also waited for the console. Now a
+// thread fills in a small LogEvent and pushes it into its own SPSCRing without any lock; a
+// background thread drains all the rings, puts the events back in operation order and does
+// the printing. A copy of the buffer is only taken for every `sample_every`-th operation.
+// Ordering holds across drains, not just within one: a thread can take an operation number and
+// be preempted before its event reaches its ring, so each writer advertises a lower bound on the
+// number it is about to take, and the printer holds events back until every lower number has
+// either arrived or been dropped.
+#pragma once
+#include <pthread.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <vector>
+#include "ring_buffer.h"
+
+#define LOG_RING_SIZE 1024      // events a thread can have waiting to be printed
+#define SNAPSHOT_ITEMS 16       // buffer items copied into a sampled event
+
+enum LogKind { LOG_INSERT, LOG_REMOVE, LOG_INSERT_ERROR, LOG_REMOVE_ERROR };
+
+// One producer or consumer operation, as recorded by the thread that did it
+struct LogEvent {
+    long seq;                   // operation number, from EventLog::next_seq()
+    LogKind kind;
+    long thread_id;             // producer or consumer ID
+    buffer_item item;           // the item inserted, or the first item removed
+    size_t count;               // items inserted or removed
+    long size;                  // items in the buffer after the operation; -1 = not sampled
+    int snapshot_len;           // items copied into snapshot; -1 = no copy
+    buffer_item snapshot[SNAPSHOT_ITEMS];   // the buffer, front first
+};
+
+class EventLog {
+public:
+    // PURPOSE: creates the log; call start() before the first add().
+    // PARAMETER: threads = number of writer threads. sample_every = take a buffer snapshot every
+    //            this many operations; 0 = never.
+    EventLog(int threads, long sample_every) : every(sample_every), seq(0), done(false) {
+        for (int i = 0; i < threads; i++) {
+            writers.emplace_back(new Writer());
+        }
+    }
+
+    // PURPOSE: starts the thread that prints the events.
+    void start() {
+        pthread_create(&printer, NULL, run_printer, this);
+    }
+
+    // PURPOSE: prints the events still waiting and stops the printing thread. Call it after
+    //          every writer has finished.
+    void stop() {
+        done.store(true, std::memory_order_release);
+        pthread_join(printer, NULL);
+        long dropped = 0;
+        for (auto& writer : writers) {
+            dropped += writer->dropped;
+        }
+        if (dropped > 0) {
+            std::cout << "(" << dropped << " log events dropped: the log could not keep up)" << std::endl;
+        }
+    }
+
+    // PURPOSE: takes the number of the next operation; called right after the operation, so under
+    //          the mutex the numbers follow the order of the buffer operations. Every call must be
+    //          followed by add() from the same slot.
+    // PARAMETER: slot = the caller's writer number (0 .. threads-1).
+    // RETURN: the operation number.
+    long next_seq(int slot) {
+        // Any number taken below is at least the current counter; the printer won't print past
+        // this floor until add() clears it
+        writers[slot]->floor.store(seq.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+        return seq.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    // RETURN: True = if operation number s should record the buffer contents. False otherwise.
+    bool sampled(long s) const { return every > 0 && s % every == 0; }
+
+    // PURPOSE: hands an event to the printing thread without blocking. If the thread's ring is
+    //          full the event is dropped and counted rather than making the caller wait.
+    // PARAMETER: slot = the caller's writer number (0 .. threads-1). event = the event.
+    void add(int slot, const LogEvent& event) {
+        Writer& writer = *writers[slot];
+        if (writer.ring.insert_item(event) != 0) {
+            writer.dropped++;
+        }
+        writer.floor.store(LONG_MAX, std::memory_order_release);
+    }
+
+private:
+    // One writer thread's ring; dropped is only written by that thread and read after stop().
+    // floor is a lower bound on the operation number the thread holds but hasn't added yet;
+    // LONG_MAX while it holds none.
+    struct Writer {
+        Writer() : ring(LOG_RING_SIZE), dropped(0), floor(LONG_MAX) {}
+        SPSCRing<LogEvent> ring;
+        long dropped;
+        std::atomic<long> floor;
+    };
+
+    // PURPOSE: the printing thread: drains every ring and prints, in operation order, the events
+    //          that no missing lower number can still precede, until stop() is called and the
+    //          rings are empty.
+    static void *run_printer(void *param) {
+        EventLog *log = (EventLog *)param;
+        std::vector<LogEvent> pending;      // drained but not printed yet, sorted by number
+        std::vector<LogEvent> events;
+        LogEvent event;
+        while (true) {
+            bool finishing = log->done.load(std::memory_order_acquire);
+
+            // Every number below bound has been added (or dropped) already: a thread that was
+            // idle when its floor was read takes a number of at least the counter read before it
+            long bound = log->seq.load(std::memory_order_seq_cst);
+            for (auto& writer : log->writers) {
+                bound = std::min(bound, writer->floor.load(std::memory_order_seq_cst));
+            }
+
+            events.clear();
+            for (auto& writer : log->writers) {
+                while (writer->ring.remove_item(&event) == 0) {
+                    events.push_back(event);
+                }
+            }
+            if (events.empty() && (pending.empty() || pending.front().seq >= bound)) {
+                if (finishing) {
+                    break;      // done was set before this drain, so nothing else is coming
+                }
+                usleep(1000);
+                continue;
+            }
+
+            auto by_seq = [](const LogEvent& a, const LogEvent& b) { return a.seq < b.seq; };
+            std::sort(events.begin(), events.end(), by_seq);
+            size_t old_size = pending.size();
+            pending.insert(pending.end(), events.begin(), events.end());
+            std::inplace_merge(pending.begin(), pending.begin() + old_size, pending.end(), by_seq);
+
+            std::ostringstream out;
+            size_t ready = 0;
+            while (ready < pending.size() && pending[ready].seq < bound) {
+                format(out, pending[ready++]);
+            }
+            pending.erase(pending.begin(), pending.begin() + ready);
+            std::cout << out.str() << std::flush;
+        }
+        return NULL;
+    }
+
+    // PURPOSE: writes an event the way the producer and consumer used to print it.
+    static void format(std::ostream& out, const LogEvent& e) {
+        bool inserting = e.kind == LOG_INSERT || e.kind == LOG_INSERT_ERROR;
+        out << (inserting ? "Producer " : "Consumer ") << e.thread_id << ": ";
+        if (e.kind == LOG_INSERT_ERROR) {
+            out << "Error inserting item\n";
+            return;
+        } else if (e.kind == LOG_REMOVE_ERROR) {
+            out << "Error removing item\n";
+            return;
+        } else if (inserting) {
+            if (e.count == 1) {
+                out << "Inserted item " << e.item << "\n";
+            } else {
+                out << "Inserted " << e.count << " x item " << e.item << "\n";
+            }
+        } else if (e.count == 1) {
+            out << "Removed item " << e.item << "\n";
+        } else {
+            out << "Removed " << e.count << " items, first " << e.item << "\n";
+        }
+
+        if (e.snapshot_len >= 0) {
+            out << "Buffer: [";
+            if (e.size == 0) {
+                out << "empty";
+            }
+            for (int i = 0; i < e.snapshot_len; i++) {
+                out << e.snapshot[i] << (i + 1 < e.snapshot_len ? ", " : "");
+            }
+            if (e.size > e.snapshot_len) {
+                out << ", ... " << e.size - e.snapshot_len << " more";
+            }
+            out << "]\n";
+        } else if (e.size >= 0) {
+            out << "Buffer: " << e.size << " items\n";
+        }
+    }
+
+    const long every;
+    std::vector<std::unique_ptr<Writer>> writers;
+    std::atomic<long> seq;
+    std::atomic<bool> done;
+    pthread_t printer;
+};
@@ -0,0 +1,275 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: harness.cpp - workload generator and throughput/latency harness
+// ===========================================================================
+// Build: g++ -O2 -pthread harness.cpp -o harness
+// Usage: ./harness [-b sem|mpmc|mpmc-yield|spsc|all] [-p producers] [-c consumers] [-i items]
+//                  [-s capacity] [-P think] [-C think] [-r seed] [-a same|split|P-CPUS:C-CPUS] [-m]
+//
+// P producers send `items` timestamps in total (default 1M) to C consumers through one buffer;
+// each consumer records how long every item spent between put() and take(). Producers think
+// for -P and consumers for -C between two operations, where a think time is "0" (default:
+// saturate the buffer), "fixed:US" or "exp:US" (exponential with mean US microseconds). Every
+// thread draws its think times from its own Rng, seeded from -r and its thread number, so a
+// run can be repeated exactly as far as the random numbers go.
+//   sem         the mutex + semaphore design of main.cpp (SemaphoreBuffer)
+//   mpmc        MPMCRing, spin, yield, then park on a futex (what main.cpp uses)
+//   mpmc-yield  MPMCRing, sched_yield while full or empty
+//   spsc        SPSCRing with the futex wait; needs -p 1 -c 1, skipped by "all" otherwise
+// The report gives items per second over the whole run and latency percentiles in
+// microseconds. An item is stamped just before put(), so its latency runs from the call to put()
+// to the return of take() and includes any time the producer spent blocked on a full buffer;
+// the "put wait" row under each buffer shows that blocked time on its own.
+// -a pins the producers and consumers (see affinity.h) and -m builds the buffer on the first
+// consumer's NUMA node, so runs with "-a same" and "-a split" show what crossing sockets costs.
+#include <pthread.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "affinity.h"
+#include "blocking_buffer.h"
+#include "ring_buffer.h"
+#include "workload.h"
+
+#define STOP_ITEM ((stamp)-1)   // sent to each consumer after the last real item
+
+// Settings shared by every run
+struct Workload {
+    int producers;
+    int consumers;
+    long items;
+    size_t capacity;
+    ThinkTime producer_think;
+    ThinkTime consumer_think;
+    uint64_t seed;
+    Placement placement;
+};
+
+// One producer or consumer thread
+template <typename Buffer>
+struct Worker {
+    Buffer *buffer;
+    const Workload *load;
+    int number;                     // 0-based, producers and consumers numbered separately
+    long items;                     // items this producer sends
+    std::vector<stamp> latencies;   // filled by a consumer
+    std::vector<stamp> put_waits;   // filled by a producer: time spent inside each put()
+};
+
+// PURPOSE: sends this producer's share of the items, each one stamped with the time put() was
+//          called, and records how long each put() took.
+// PARAMETER: *param = the Worker.
+template <typename Buffer>
+void *harness_producer(void *param) {
+    Worker<Buffer> *w = (Worker<Buffer> *)param;
+    Rng rng(w->load->seed * 2654435761ULL + w->number);
+    for (long i = 0; i < w->items; i++) {
+        w->load->producer_think.think(rng);
+        stamp called = now_ns();
+        w->buffer->put(called);
+        w->put_waits.push_back(now_ns() - called);
+    }
+    return NULL;
+}
+
+// PURPOSE: takes items until STOP_ITEM and records the latency of every one.
+// PARAMETER: *param = the Worker.
+template <typename Buffer>
+void *harness_consumer(void *param) {
+    Worker<Buffer> *w = (Worker<Buffer> *)param;
+    Rng rng(w->load->seed * 2654435761ULL + 0x10000 + w->number);
+    while (true) {
+        stamp sent = w->buffer->take();
+        if (sent == STOP_ITEM) {
+            break;
+        }
+        w->latencies.push_back(now_ns() - sent);
+        w->load->consumer_think.think(rng);
+    }
+    return NULL;
+}
+
+// PURPOSE: prints the p50, p90, p99, p99.9 and max columns of the report.
+// PARAMETER: values = nanoseconds; sorted in place.
+void print_percentiles(std::vector<stamp>& values) {
+    std::sort(values.begin(), values.end());
+    auto percentile = [&](double p) {
+        return values.empty() ? 0.0 : values[(size_t)(p * (values.size() - 1))] / 1000.0;
+    };
+    std::cout << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << percentile(0.50) << std::setw(10) << percentile(0.90)
+              << std::setw(10) << percentile(0.99) << std::setw(10) << percentile(0.999)
+              << std::setw(11) << percentile(1.0);
+}
+
+// PURPOSE: runs the workload over one buffer and prints its lines of the report.
+// PARAMETER: name = buffer name. load = the workload.
+template <typename Buffer>
+void run(const char *name, const Workload& load) {
+    std::unique_ptr<Buffer> owner;
+    run_on_cpu(load.placement.buffer_cpu(), [&] { owner.reset(new Buffer(load.capacity)); });
+    Buffer& buffer = *owner;
+    std::vector<Worker<Buffer>> producers(load.producers), consumers(load.consumers);
+    std::vector<pthread_t> producer_threads(load.producers), consumer_threads(load.consumers);
+
+    for (int i = 0; i < load.consumers; i++) {
+        consumers[i] = Worker<Buffer>{&buffer, &load, i, 0, {}, {}};
+        consumers[i].latencies.reserve(load.items / load.consumers + 1);
+    }
+    for (int i = 0; i < load.producers; i++) {
+        // the first items % producers producers send one extra item
+        long share = load.items / load.producers + (i < load.items % load.producers ? 1 : 0);
+        producers[i] = Worker<Buffer>{&buffer, &load, i, share, {}, {}};
+        producers[i].put_waits.reserve(share);
+    }
+
+    stamp start = now_ns();
+    // A run missing a thread would measure something else (or never finish, without a consumer),
+    // so a thread that can't be created ends the harness; create_pinned_thread reported why
+    for (int i = 0; i < load.consumers; i++) {
+        if (create_pinned_thread(&consumer_threads[i], load.placement.consumer_cpu(i), harness_consumer<Buffer>,
+                                 &consumers[i]) != 0) {
+            exit(1);
+        }
+    }
+    for (int i = 0; i < load.producers; i++) {
+        if (create_pinned_thread(&producer_threads[i], load.placement.producer_cpu(i), harness_producer<Buffer>,
+                                 &producers[i]) != 0) {
+            exit(1);
+        }
+    }
+    for (int i = 0; i < load.producers; i++) {
+        pthread_join(producer_threads[i], NULL);
+    }
+    for (int i = 0; i < load.consumers; i++) {
+        buffer.put(STOP_ITEM);          // queued behind every real item
+    }
+    for (int i = 0; i < load.consumers; i++) {
+        pthread_join(consumer_threads[i], NULL);
+    }
+    double seconds = (now_ns() - start) / 1e9;
+
+    std::vector<stamp> lat, waits;
+    lat.reserve(load.items);
+    waits.reserve(load.items);
+    for (auto& c : consumers) {
+        lat.insert(lat.end(), c.latencies.begin(), c.latencies.end());
+    }
+    for (auto& p : producers) {
+        waits.insert(waits.end(), p.put_waits.begin(), p.put_waits.end());
+    }
+
+    std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(11) << lat.size() / seconds / 1e6;
+    print_percentiles(lat);
+    if ((long)lat.size() != load.items) {
+        std::cout << "  LOST " << load.items - (long)lat.size() << " ITEMS";
+    }
+    std::cout << "\n" << std::left << std::setw(12) << "  put wait" << std::setw(11) << "";
+    print_percentiles(waits);
+    std::cout << std::endl;
+}
+
+// PURPOSE: writes a think time the way -P/-C take it.
+// RETURN: e.g. "exp:100".
+std::string think_name(const ThinkTime& think) {
+    if (think.kind == THINK_ZERO) {
+        return "0";
+    }
+    std::ostringstream out;
+    out << (think.kind == THINK_FIXED ? "fixed:" : "exp:") << think.mean_us;
+    return out.str();
+}
+
+// PURPOSE: prints how to run the harness.
+void usage() {
+    std::cout << "Usage: ./harness [-b sem|mpmc|mpmc-yield|spsc|all] [-p producers] [-c consumers] [-i items]\n"
+              << "                 [-s capacity] [-P think] [-C think] [-r seed] [-a placement] [-m]\n"
+              << "  think time: 0 (default), fixed:US or exp:US (mean US microseconds)\n"
+              << "  placement: same, split or PRODUCER-CPUS:CONSUMER-CPUS, e.g. 0-3:4-7\n"
+              << "  -m  allocate the buffer on the first consumer's NUMA node (needs -a)" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    Workload load{4, 4, 1000000, 1024, {THINK_ZERO, 0}, {THINK_ZERO, 0}, 1, {{}, {}, false}};
+    const char *kind = "all";
+    int opt;
+    while ((opt = getopt(argc, argv, "b:p:c:i:s:P:C:r:a:m")) != -1) {
+        bool ok = true;
+        if (opt == 'b') {
+            kind = optarg;
+        } else if (opt == 'p') {
+            ok = (load.producers = atoi(optarg)) > 0;
+        } else if (opt == 'c') {
+            ok = (load.consumers = atoi(optarg)) > 0;
+        } else if (opt == 'i') {
+            ok = (load.items = atol(optarg)) > 0;
+        } else if (opt == 's') {
+            ok = (load.capacity = atol(optarg)) > 0;
+        } else if (opt == 'P') {
+            ok = parse_think_time(optarg, &load.producer_think);
+        } else if (opt == 'C') {
+            ok = parse_think_time(optarg, &load.consumer_think);
+        } else if (opt == 'r') {
+            load.seed = strtoull(optarg, NULL, 10);
+        } else if (opt == 'a') {
+            ok = parse_placement(optarg, &load.placement);
+        } else if (opt == 'm') {
+            load.placement.buffer_on_consumer_node = true;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            usage();
+            exit(1);
+        }
+    }
+    if (!check_placement(load.placement)) {
+        usage();
+        exit(1);
+    }
+    bool all = strcmp(kind, "all") == 0;
+    bool single = load.producers == 1 && load.consumers == 1;
+    if (strcmp(kind, "spsc") == 0 && !single) {
+        std::cout << "The spsc buffer needs -p 1 -c 1" << std::endl;
+        exit(1);
+    }
+
+    std::cout << "producers: " << load.producers << ", consumers: " << load.consumers
+              << ", items: " << load.items << ", capacity: " << load.capacity
+              << ", think: " << think_name(load.producer_think) << " / "
+              << think_name(load.consumer_think) << "\n"
+              << "placement: " << load.placement.describe() << "\n";
+    std::cout << "buffer       Mitems/s    p50_us    p90_us    p99_us   p999_us     max_us\n";
+    bool ran = false;
+    if (all || strcmp(kind, "sem") == 0) {
+        run<SemaphoreBuffer<stamp>>("sem", load);
+        ran = true;
+    }
+    if (all || strcmp(kind, "mpmc") == 0) {
+        run<BlockingRing<MPMCRing<stamp>, FutexWait>>("mpmc", load);
+        ran = true;
+    }
+    if (all || strcmp(kind, "mpmc-yield") == 0) {
+        run<BlockingRing<MPMCRing<stamp>, YieldWait>>("mpmc-yield", load);
+        ran = true;
+    }
+    if ((all && single) || strcmp(kind, "spsc") == 0) {
+        run<BlockingRing<SPSCRing<stamp>, FutexWait>>("spsc", load);
+        ran = true;
+    }
+    if (!ran) {
+        usage();
+        exit(1);
+    }
+    return 0;
+}
@@ -10,121 +10,439 @@
 #include <stdlib.h> 
 #include <time.h> 
 #include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include "affinity.h"
 #include "buffer.h"
+#include "ring_buffer.h"
+#include "blocking_buffer.h"
+#include "event_log.h"
+#include "workload.h"
 
 // semaphores needed for synchronization
 pthread_mutex_t mutex;  // mutex lock
 sem_t full;             // counting semaphore
 sem_t empty;            // counting semaphore
 
-// forward declarations used in producer consumer functions
-int insert_item(buffer_item item);
-int remove_item(buffer_item *item);
-void display();
+// the buffer shared by the producer and consumer functions, guarded by the mutex
+BoundedBuffer<buffer_item> *buffer;
 
-// PURPOSE: produces an item in the buffer.
-// PARAMETER: *param = used to pass pthread_create function
+// items moved per buffer operation (-n); 1 is the original one-item protocol
+long batch_size = 1;
+
+// Shutdown protocol: main sets stopping, wakes any producer blocked on a full buffer and joins
+// the producers, then sets producers_done and wakes the consumers, which empty the buffer
+// without sleeping and exit once it is empty.
+std::atomic<bool> stopping(false);
+std::atomic<bool> producers_done(false);
+std::atomic<long> produced(0);      // items inserted by all producers
+std::atomic<long> consumed(0);      // items removed by all consumers
+
+// Arguments of a producer or consumer thread
+struct ThreadArg {
+    long id;        // thread ID, starting at 1
+    int slot;       // the thread's writer number in the event log
+    void *ring;     // the BlockingRing shared by all threads; unused with the mutex buffer
+};
+
+// the event log that prints what the threads do; NULL with -q
+EventLog *event_log = NULL;
+
+// rand() shares one state between all threads, so each thread draws its sleep times from its
+// own Rng(seed + slot)
+uint64_t seed;
+
+// PURPOSE: starts an event for the operation just done. Called under the mutex in the mutex
+//          mode, so the operation numbers follow the order of the buffer operations.
+//          The caller must hand the event to event_log->add() afterwards.
+// PARAMETER: kind = what happened. arg = the calling thread. item = the item. count = how many.
+// RETURN: the event, with its operation number.
+LogEvent make_event(LogKind kind, const ThreadArg *arg, buffer_item item, size_t count) {
+    LogEvent event;
+    event.seq = event_log->next_seq(arg->slot);
+    event.kind = kind;
+    event.thread_id = arg->id;
+    event.item = item;
+    event.count = count;
+    event.size = -1;
+    event.snapshot_len = -1;
+    return event;
+}
+
+// PURPOSE: produces an item in the buffer. With a batch size above 1 a producer claims as many
+//          free slots as it can get without blocking, up to a batch, and fills them under one lock.
+//          Only the buffer operation (and a sampled copy of the buffer) happens under the lock;
+//          the event is printed later by the event log.
+// PARAMETER: *param = the ThreadArg.
 void* producer(void *param)
 {
-    // Get producer ID from param (starting at 1)
-    long producer_id = (long)param;
+    ThreadArg *arg = (ThreadArg *)param;
+    Rng rng(seed + arg->slot);
+    long producer_id = arg->id;
     buffer_item item = producer_id;  // Producer inserts its own ID
+    std::vector<buffer_item> items(batch_size, item);
 
     while (true) {
         // Sleep for random time under 1 second (1,000,000 microseconds)
-        usleep(rand() % 1000000);
+        usleep(rng.below(1000000));
+        if (stopping) {
+            break;
+        }
         
         sem_wait(&empty);                   // acquire the semaphore, wait till not full
+        if (stopping) {
+            break;                          // woken by main to stop, or stopped while waiting
+        }
+        long claimed = 1;                   // free slots this producer may fill
+        while (claimed < batch_size && sem_trywait(&empty) == 0) {
+            claimed++;
+        }
         pthread_mutex_lock(&mutex);         // enforce the mutex to access critical section
 
         // critical section ...
-        if (insert_item(item) == 0) {
-            std::cout << "Producer " << producer_id << ": Inserted item " << item << std::endl;
-            std::cout << "Buffer: ";
-            display();
+        size_t inserted;
+        if (claimed > 1) {
+            inserted = buffer->insert_batch(items.data(), claimed);
+        } else {
+            inserted = buffer->insert_item(item) == 0 ? 1 : 0;
         }
-        else {
-            std::cout << "Producer " << producer_id << ": Error inserting item" << std::endl;
+        LogEvent event;
+        if (event_log) {
+            event = make_event(inserted > 0 ? LOG_INSERT : LOG_INSERT_ERROR, arg, item, inserted);
+            if (event_log->sampled(event.seq)) {
+                event.size = buffer->size();
+                event.snapshot_len = buffer->snapshot(event.snapshot, SNAPSHOT_ITEMS);
+            }
         }
         // end of critical section ...
 
         pthread_mutex_unlock(&mutex);       // unlock the mutex
-        sem_post(&full);                    // release the semaphore, increment full
+        for (long i = 0; i < claimed; i++) {
+            sem_post(&full);                // release the semaphore, increment full
+        }
+        produced += inserted;
+        if (event_log) {
+            event_log->add(arg->slot, event);
+        }
     }
+    return NULL;
 }
 
-// PURPOSE: consumes an item in the buffer.
-// PARAMETER: *param = used to pass pthread_create function
+// PURPOSE: consumes an item in the buffer. With a batch size above 1 a consumer takes as many
+//          items as are there, up to a batch, under one lock. Like producer(), it only does the
+//          buffer operation under the lock and leaves the printing to the event log.
+// PARAMETER: *param = the ThreadArg.
 void *consumer(void *param)
 {
-    // Get consumer ID from param
-    long consumer_id = (long)param;
-    buffer_item item;
+    ThreadArg *arg = (ThreadArg *)param;
+    Rng rng(seed + arg->slot);
+    std::vector<buffer_item> items(batch_size);
 
     while (true) {
-        // Sleep for random time under 1 second (1,000,000 microseconds)
-        usleep(rand() % 1000000);
+        // Sleep for random time under 1 second (1,000,000 microseconds), except while draining
+        if (!producers_done) {
+            usleep(rng.below(1000000));
+        }
         
         sem_wait(&full);                    // acquire the semaphore, wait til not empty
+        long claimed = 1;                   // items this consumer may take
+        while (claimed < batch_size && sem_trywait(&full) == 0) {
+            claimed++;
+        }
         pthread_mutex_lock(&mutex);         // enforce the mutex to access critical section
 
         // critical section ...
-        if (remove_item(&item) == 0) {
-            std::cout << "Consumer " << consumer_id << ": Removed item " << item << std::endl;
-            std::cout << "Buffer: ";
-            display();
+        size_t removed;
+        if (claimed > 1) {
+            removed = buffer->remove_batch(items.data(), claimed);
+        } else {
+            removed = buffer->remove_item(&items[0]) == 0 ? 1 : 0;
         }
-        else {
-            std::cout << "Consumer " << consumer_id << ": Error removing item" << std::endl;
+        // after the producers are done, an empty buffer is how a consumer learns to exit
+        bool log_it = event_log && (removed > 0 || !producers_done);
+        LogEvent event;
+        if (log_it) {
+            event = make_event(removed > 0 ? LOG_REMOVE : LOG_REMOVE_ERROR, arg, items[0], removed);
+            if (event_log->sampled(event.seq)) {
+                event.size = buffer->size();
+                event.snapshot_len = buffer->snapshot(event.snapshot, SNAPSHOT_ITEMS);
+            }
         }
         // end of critical section ...
 
         pthread_mutex_unlock(&mutex);       // unlock the mutex
-        sem_post(&empty);                   // release the semaphore, decrement empty
+        for (size_t i = 0; i < removed; i++) {
+            sem_post(&empty);               // release the semaphore, decrement empty
+        }
+        consumed += removed;
+        if (log_it) {
+            event_log->add(arg->slot, event);
+        }
+
+        // After the producers are done, a wake-up that finds fewer items than it was promised
+        // means the buffer is drained: pass the wake-up on to the next consumer and exit
+        if (producers_done && (long)removed < claimed) {
+            sem_post(&full);
+            break;
+        }
+    }
+    return NULL;
+}
+
+// PURPOSE: produces items into a lock-free ring; no lock or semaphore is involved, and a
+//          producer that finds the ring full spins, yields, then parks on a futex.
+// PARAMETER: *param = the ThreadArg.
+template <typename Ring>
+void *ring_producer(void *param)
+{
+    ThreadArg *arg = (ThreadArg *)param;
+    Rng rng(seed + arg->slot);
+    Ring *ring = (Ring *)arg->ring;
+    buffer_item item = arg->id;     // Producer inserts its own ID
+    std::vector<buffer_item> items(batch_size, item);
+
+    while (true) {
+        usleep(rng.below(1000000));
+        if (stopping) {
+            break;
+        }
+
+        size_t inserted = 0;
+        while (inserted < (size_t)batch_size && !stopping) {
+            size_t count = ring->put_batch(items.data() + inserted, batch_size - inserted);
+            if (count == 0) {
+                break;                      // stopped while the ring was full
+            }
+            inserted += count;
+        }
+        if (inserted == 0) {
+            break;
+        }
+        produced += inserted;
+        if (event_log) {
+            // a lock-free ring can't be copied consistently, so a sampled event records its size
+            LogEvent event = make_event(LOG_INSERT, arg, item, inserted);
+            if (event_log->sampled(event.seq)) {
+                event.size = ring->ring().size();
+            }
+            event_log->add(arg->slot, event);
+        }
     }
+    return NULL;
+}
+
+// PURPOSE: consumes items from a lock-free ring; no lock or semaphore is involved, and a
+//          consumer that finds the ring empty spins, yields, then parks on a futex.
+// PARAMETER: *param = the ThreadArg.
+template <typename Ring>
+void *ring_consumer(void *param)
+{
+    ThreadArg *arg = (ThreadArg *)param;
+    Rng rng(seed + arg->slot);
+    Ring *ring = (Ring *)arg->ring;
+    std::vector<buffer_item> items(batch_size);
+
+    while (true) {
+        if (!producers_done) {
+            usleep(rng.below(1000000));
+        }
+
+        // 0 means the ring was closed and is drained
+        size_t removed = ring->take_batch(items.data(), batch_size);
+        if (removed == 0) {
+            break;
+        }
+        consumed += removed;
+        if (event_log) {
+            LogEvent event = make_event(LOG_REMOVE, arg, items[0], removed);
+            if (event_log->sampled(event.seq)) {
+                event.size = ring->ring().size();
+            }
+            event_log->add(arg->slot, event);
+        }
+    }
+    return NULL;
+}
+
+// PURPOSE: prints how to run the program.
+void usage() {
+    std::cout << "Usage: ./prog4 [-b mutex|mpmc|spsc] [-s capacity] [-n batch] [-d every] [-q] [-a placement] [-m] <sleeptime> <pthreadc> <cthreadc>" << std::endl;
+    std::cout << "  -b  buffer: mutex + semaphores (default), lock-free multi-producer/multi-consumer\n"
+              << "      ring, or lock-free single-producer/single-consumer ring (1 producer, 1 consumer)\n"
+              << "  -s  buffer capacity (default " << BUFFER_SIZE << "); the rings round it up to a power of two\n"
+              << "  -n  items moved per buffer operation (default 1)\n"
+              << "  -d  show the buffer after every n-th operation (default 1, 0 = never)\n"
+              << "  -q  don't print the operations\n"
+              << "  -a  pin the threads: same (one NUMA node), split (producers and consumers on different\n"
+              << "      nodes) or PRODUCER-CPUS:CONSUMER-CPUS such as 0-3:4-7\n"
+              << "  -m  allocate the buffer on the first consumer's NUMA node (needs -a)"
+              << std::endl;
 }
 
 // This is the driver to test out the implementation for solving the producer consumer problem.
 int main(int argc, char *argv[])
 {
     // input handling
-    if (argc != 4) {
-        std::cout << "Usage: ./prog4 <sleeptime> <pthreadc> <cthreadc>" << std::endl;
+    const char *buffer_kind = "mutex";
+    long capacity = BUFFER_SIZE;
+    long sample_every = 1;
+    bool quiet = false;
+    Placement placement{{}, {}, false};
+    int opt;
+    while ((opt = getopt(argc, argv, "b:s:n:d:qa:m")) != -1) {
+        if (opt == 'b') {
+            buffer_kind = optarg;
+        } else if (opt == 's' && atol(optarg) > 0) {
+            capacity = atol(optarg);
+        } else if (opt == 'n' && atol(optarg) > 0) {
+            batch_size = atol(optarg);
+        } else if (opt == 'd' && atol(optarg) >= 0) {
+            sample_every = atol(optarg);
+        } else if (opt == 'q') {
+            quiet = true;
+        } else if (opt == 'a') {
+            if (!parse_placement(optarg, &placement)) {
+                usage();
+                exit(1);
+            }
+        } else if (opt == 'm') {
+            placement.buffer_on_consumer_node = true;
+        } else {
+            usage();
+            exit(1);
+        }
+    }
+    if (argc - optind != 3 || !check_placement(placement) ||
+        (strcmp(buffer_kind, "mutex") != 0 && strcmp(buffer_kind, "mpmc") != 0 && strcmp(buffer_kind, "spsc") != 0)) {
+        usage();
         exit(1);
     }
 
-    srand(time(NULL));
+    seed = time(NULL);
 
     // 1. Get command line arguments argv[1], argv[2], argv[3]
-    int sleeptime = atoi(argv[1]);      // 1st arg is the sleep time
-    int pthreadc = atoi(argv[2]);       // 2nd arg is the # of producer threads
-    int cthreadc = atoi(argv[3]);       // 3rd arg is the # of consumer threads
+    int sleeptime = atoi(argv[optind]);         // 1st arg is the sleep time
+    int pthreadc = atoi(argv[optind + 1]);      // 2nd arg is the # of producer threads
+    int cthreadc = atoi(argv[optind + 2]);      // 3rd arg is the # of consumer threads
+
+    if (strcmp(buffer_kind, "spsc") == 0 && (pthreadc != 1 || cthreadc != 1)) {
+        std::cout << "The spsc buffer needs exactly 1 producer and 1 consumer" << std::endl;
+        exit(1);
+    }
 
     // 2. Initialize buffer / threads / semaphores
-    pthread_t producer_threads[pthreadc];
-    pthread_t consumer_threads[cthreadc];
-    pthread_mutex_init(&mutex, NULL);
-    sem_init(&empty, 0, BUFFER_SIZE);   // empty initialized to buffer size
-    sem_init(&full, 0, 0);              // full initialized to 0
+    bool use_mutex = strcmp(buffer_kind, "mutex") == 0;
+    bool use_mpmc = strcmp(buffer_kind, "mpmc") == 0;
+    typedef BlockingRing<MPMCRing<buffer_item> > MPMCBuffer;
+    typedef BlockingRing<SPSCRing<buffer_item> > SPSCBuffer;
+    MPMCBuffer *mpmc = NULL;
+    SPSCBuffer *spsc = NULL;
+    pthread_t threads[pthreadc + cthreadc];     // producers first, then consumers
+    bool created[pthreadc + cthreadc];          // only these threads are joined
+    bool all_created = true;
+    ThreadArg args[pthreadc + cthreadc];
+
+    // with -m the buffer is built on the first consumer's CPU, which places it on that node
+    run_on_cpu(placement.buffer_cpu(), [&] {
+        if (use_mutex) {
+            buffer = new BoundedBuffer<buffer_item>(capacity);
+        } else if (use_mpmc) {
+            mpmc = new MPMCBuffer(capacity);    // lock-free: every thread works on the ring directly
+        } else {
+            spsc = new SPSCBuffer(capacity);
+        }
+    });
+    if (use_mutex) {
+        pthread_mutex_init(&mutex, NULL);
+        sem_init(&empty, 0, capacity);      // empty initialized to buffer size
+        sem_init(&full, 0, 0);              // full initialized to 0
+    }
+    if (!placement.producer_cpus.empty() || placement.buffer_cpu() >= 0) {
+        std::cout << "Placement: " << placement.describe() << std::endl;
+    }
 
-    // 3. Create producer thread(s)
-    for (int i = 0; i < pthreadc; i++)
-        pthread_create(&producer_threads[i], NULL, producer, (void*)(long)(i+1));  // IDs start from 1
+    // every thread writes to its own ring in the event log; one background thread prints
+    if (!quiet) {
+        event_log = new EventLog(pthreadc + cthreadc, sample_every);
+        event_log->start();
+    }
 
-    // 4. Create consumer thread(s)
-    for (int i = 0; i < cthreadc; i++)
-        pthread_create(&consumer_threads[i], NULL, consumer, (void*)(long)(i+1));  // IDs start from 1
+    // 3. Create producer thread(s) and 4. consumer thread(s)
+    for (int i = 0; i < pthreadc + cthreadc; i++) {
+        bool is_producer = i < pthreadc;
+        long id = is_producer ? i + 1 : i - pthreadc + 1;      // IDs start from 1
+        int cpu = is_producer ? placement.producer_cpu(id - 1) : placement.consumer_cpu(id - 1);
+        args[i] = ThreadArg{id, i, use_mpmc ? (void *)mpmc : (void *)spsc};
+        void *(*start)(void *);
+        if (use_mutex) {
+            start = is_producer ? producer : consumer;
+        } else if (use_mpmc) {
+            start = is_producer ? ring_producer<MPMCBuffer> : ring_consumer<MPMCBuffer>;
+        } else {
+            start = is_producer ? ring_producer<SPSCBuffer> : ring_consumer<SPSCBuffer>;
+        }
+        // cpu -1: wherever the OS likes. A thread that can't be created was already reported;
+        // the run goes on without it and the shutdown below copes with missing threads
+        created[i] = create_pinned_thread(&threads[i], cpu, start, &args[i]) == 0;
+        all_created = all_created && created[i];
+    }
 
     // 5. Sleep 
     sleep(sleeptime);
 
-    std::cout << "\nThreads finished! Exiting... \n";
+    // 6. Stop the producers, then let the consumers drain the buffer and join everyone
+    std::cout << "\nStopping producers...\n";
+    stopping = true;
+    // a producer blocked on a full buffer (e.g. with no consumers) would never see stopping
+    if (use_mutex) {
+        for (int i = 0; i < pthreadc; i++) {
+            sem_post(&empty);
+        }
+    } else if (use_mpmc) {
+        mpmc->stop_producers();
+    } else {
+        spsc->stop_producers();
+    }
+    for (int i = 0; i < pthreadc; i++) {
+        if (created[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+    producers_done = true;
+    if (use_mutex) {
+        sem_post(&full);                    // wakes one consumer; each one passes it on
+    } else if (use_mpmc) {
+        mpmc->close();
+    } else {
+        spsc->close();
+    }
+    for (int i = pthreadc; i < pthreadc + cthreadc; i++) {
+        if (created[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+    if (event_log) {
+        event_log->stop();                  // prints whatever the threads logged last
+        delete event_log;
+    }
 
-    // 6. Destroy the mutex and semaphores before exiting
-    pthread_mutex_destroy(&mutex);
-    sem_destroy(&empty);
-    sem_destroy(&full);
+    // 7. Report what happened to every item
+    long left = use_mutex ? buffer->size() : use_mpmc ? mpmc->ring().size() : spsc->ring().size();
+    std::cout << "\nThreads finished! Exiting... \n";
+    std::cout << "Items produced: " << produced << "\n"
+              << "Items consumed: " << consumed << "\n"
+              << "Items in flight: " << produced - consumed << " (" << left << " left in buffer, "
+              << produced - consumed - left << " lost)" << std::endl;
 
-    // 7. Exit 
-    exit(0);
+    // 8. Destroy the mutex and semaphores before exiting
+    if (use_mutex) {
+        pthread_mutex_destroy(&mutex);
+        sem_destroy(&empty);
+        sem_destroy(&full);
+        delete buffer;
+    }
+    delete mpmc;
+    delete spsc;
+    return all_created ? 0 : 1;
 }
@@ -0,0 +1,297 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: pipeline.h - header file (multi-stage pipeline of bounded buffers)
+// ===========================================================================
+// A Pipeline chains stages with bounded buffers: the first stage's workers make items, every
+// later stage's workers take an item from the buffer before it, transform it and put it into
+// the buffer after it (the last stage has none, it is the sink). Each stage has its own pool
+// of worker threads. Because the buffers are bounded, a slow stage fills the buffer in front
+// of it and the stages before it block on put(): backpressure travels upstream by itself.
+// For every stage the pipeline counts
+//   starved  takes that found the input buffer empty, and the time spent waiting for an item
+//   blocked  puts that found the output buffer full, and the time spent waiting for room
+// and a monitor thread samples how full each input buffer is. The bottleneck is the stage
+// whose workers hardly wait: the stages before it are blocked and the ones after it starve.
+#pragma once
+#include <pthread.h>
+#include <unistd.h>
+#include <atomic>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "blocking_buffer.h"
+#include "ring_buffer.h"
+#include "workload.h"
+
+// Counters of one stage, summed over its workers
+struct StageStats {
+    long items;                 // items the stage passed on (or consumed, for the sink)
+    long starved;               // takes that had to wait for an item
+    long blocked;               // puts that had to wait for room
+    stamp starved_ns;           // total time the workers waited for an item
+    stamp blocked_ns;           // total time the workers waited for room
+    double occupancy_avg;       // average items in the input buffer; 0 for the first stage
+    size_t occupancy_max;       // most items seen in the input buffer
+    size_t capacity;            // input buffer capacity; 0 for the first stage
+};
+
+template <typename T>
+class Pipeline {
+public:
+    typedef std::function<bool(int worker, T *item)> Source;   // false = no more items
+    typedef std::function<void(T& item)> Transform;
+    typedef BlockingRing<MPMCRing<T>, FutexWait> Buffer;
+
+    // PARAMETER: capacity = capacity of every buffer between two stages.
+    explicit Pipeline(size_t capacity) : capacity(capacity), rejected(false), done(false), start_ns(0), end_ns(0) {}
+
+    // PURPOSE: sets the first stage; call it before add_stage().
+    // PARAMETER: name = stage name. workers = threads, at least 1. source = called by each worker
+    //            until it returns false; it must be safe to call from all of them at once.
+    // RETURN: True = if the stage was added. False = if workers < 1; start() then fails too.
+    bool add_source(const std::string& name, int workers, Source source) {
+        if (!check_workers(name, workers)) {
+            return false;
+        }
+        stages.emplace_back(new Stage(name, workers));
+        stages.back()->source = source;
+        return true;
+    }
+
+    // PURPOSE: appends a stage; the last one added is the sink.
+    // PARAMETER: name = stage name. workers = threads, at least 1. transform = applied to every item.
+    // RETURN: True = if the stage was added. False = if workers < 1; start() then fails too.
+    bool add_stage(const std::string& name, int workers, Transform transform) {
+        if (!check_workers(name, workers)) {
+            return false;
+        }
+        stages.emplace_back(new Stage(name, workers));
+        stages.back()->transform = transform;
+        return true;
+    }
+
+    // PURPOSE: creates the buffers and starts every worker and the monitor.
+    // RETURN: True = if the pipeline started. False = if it has no source or no stage after it.
+    bool start() {
+        if (rejected) {
+            std::cerr << "Pipeline: a stage was rejected" << std::endl;
+            return false;
+        }
+        if (stages.size() < 2 || !stages[0]->source) {
+            std::cerr << "Pipeline: needs a source and at least one stage" << std::endl;
+            return false;
+        }
+        for (size_t i = 1; i < stages.size(); i++) {
+            buffers.emplace_back(new Buffer(capacity));
+            stages[i - 1]->out = buffers.back().get();
+            stages[i]->in = buffers.back().get();
+        }
+        start_ns = now_ns();
+        for (size_t s = 0; s < stages.size(); s++) {
+            Stage& stage = *stages[s];
+            for (int w = 0; w < stage.workers; w++) {
+                stage.counters.emplace_back(new Counters());
+                stage.args.push_back(WorkerArg{this, &stage, w});
+            }
+            stage.running = stage.workers;
+            for (int w = 0; w < stage.workers; w++) {
+                pthread_t thread;
+                pthread_create(&thread, NULL, run_worker, &stage.args[w]);
+                threads.push_back(thread);
+            }
+        }
+        pthread_create(&monitor, NULL, run_monitor, this);
+        return true;
+    }
+
+    // PURPOSE: waits until the source is exhausted and every item has left the sink.
+    void wait() {
+        for (pthread_t thread : threads) {
+            pthread_join(thread, NULL);
+        }
+        end_ns = now_ns();
+        done = true;
+        pthread_join(monitor, NULL);
+    }
+
+    // RETURN: the number of stages.
+    size_t size() const { return stages.size(); }
+
+    // RETURN: seconds since start(), up to wait() once it has returned.
+    double seconds() const { return ((end_ns ? end_ns : now_ns()) - start_ns) / 1e9; }
+
+    // PURPOSE: reads a stage's counters; may be called while the pipeline runs.
+    // PARAMETER: s = stage number, 0 = the source.
+    // RETURN: the counters summed over the stage's workers.
+    StageStats stats(size_t s) const {
+        const Stage& stage = *stages[s];
+        StageStats st = {0, 0, 0, 0, 0, 0, 0, stage.in ? stage.in->ring().capacity() : 0};
+        for (const auto& c : stage.counters) {
+            st.items += c->items.load(std::memory_order_relaxed);
+            st.starved += c->starved.load(std::memory_order_relaxed);
+            st.blocked += c->blocked.load(std::memory_order_relaxed);
+            st.starved_ns += c->starved_ns.load(std::memory_order_relaxed);
+            st.blocked_ns += c->blocked_ns.load(std::memory_order_relaxed);
+        }
+        long samples = stage.samples.load(std::memory_order_relaxed);
+        st.occupancy_avg = samples ? (double)stage.occupancy_sum.load(std::memory_order_relaxed) / samples : 0;
+        st.occupancy_max = stage.occupancy_max.load(std::memory_order_relaxed);
+        return st;
+    }
+
+    // PURPOSE: prints one line per stage and names the stage that waited least.
+    // PARAMETER: out = where to print.
+    void report(std::ostream& out) const {
+        double wall_ns = seconds() * 1e9;
+        out << "stage       workers      items  starved%  blocked%  in_avg  in_max/cap\n";
+        size_t bottleneck = 0;
+        double least_wait = 2;
+        for (size_t s = 0; s < stages.size(); s++) {
+            const Stage& stage = *stages[s];
+            StageStats st = stats(s);
+            double thread_ns = wall_ns * stage.workers;
+            double starved = st.starved_ns / thread_ns, blocked = st.blocked_ns / thread_ns;
+            if (starved + blocked < least_wait) {
+                least_wait = starved + blocked;
+                bottleneck = s;
+            }
+            out << std::left << std::setw(12) << stage.name << std::right << std::setw(7) << stage.workers
+                << std::setw(11) << st.items << std::fixed << std::setprecision(1)
+                << std::setw(10) << 100 * starved << std::setw(10) << 100 * blocked;
+            if (stage.in) {
+                out << std::setw(8) << st.occupancy_avg << std::setw(7) << st.occupancy_max
+                    << "/" << st.capacity;
+            } else {
+                out << std::setw(8) << "-" << std::setw(7) << "-";
+            }
+            out << "\n";
+        }
+        out << "bottleneck: " << stages[bottleneck]->name << " (its workers waited "
+            << std::setprecision(1) << 100 * least_wait << "% of the time)" << std::endl;
+    }
+
+private:
+    // One worker's counters: written only by that worker, read by stats()
+    struct alignas(CACHE_LINE_SIZE) Counters {
+        std::atomic<long> items{0}, starved{0}, blocked{0};
+        std::atomic<stamp> starved_ns{0}, blocked_ns{0};
+    };
+
+    struct Stage;
+    struct WorkerArg {
+        Pipeline *pipeline;
+        Stage *stage;
+        int worker;
+    };
+
+    struct Stage {
+        Stage(const std::string& name, int workers)
+            : name(name), workers(workers), in(NULL), out(NULL), running(0),
+              occupancy_sum(0), occupancy_max(0), samples(0)
+        {
+        }
+        std::string name;
+        int workers;
+        Source source;              // set for the first stage only
+        Transform transform;        // set for the other stages
+        Buffer *in;                 // NULL for the first stage
+        Buffer *out;                // NULL for the sink
+        std::vector<std::unique_ptr<Counters>> counters;
+        std::vector<WorkerArg> args;
+        std::atomic<int> running;   // workers still running; the last one closes `out`
+        std::atomic<long> occupancy_sum;        // written by the monitor only
+        std::atomic<size_t> occupancy_max;
+        std::atomic<long> samples;
+    };
+
+    // PURPOSE: rejects a stage without workers: nothing would ever close its output, so every
+    //          stage after it would wait forever.
+    // RETURN: True = if workers >= 1.
+    bool check_workers(const std::string& name, int workers) {
+        if (workers < 1) {
+            std::cerr << "Pipeline: stage " << name << " needs at least 1 worker" << std::endl;
+            rejected = true;
+            return false;
+        }
+        return true;
+    }
+
+    // PURPOSE: adds to a counter only its owner writes; a plain load and store, no RMW.
+    template <typename N>
+    static void bump(std::atomic<N>& counter, N by) {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    // PURPOSE: a worker: get an item (from the source or the input buffer), transform it and
+    //          pass it on, until the source is exhausted or the input buffer is closed and empty.
+    static void *run_worker(void *param) {
+        WorkerArg *arg = (WorkerArg *)param;
+        Stage& stage = *arg->stage;
+        Counters& c = *stage.counters[arg->worker];
+        T item;
+        while (true) {
+            if (stage.source) {
+                if (!stage.source(arg->worker, &item)) {
+                    break;
+                }
+            } else {
+                if (!stage.in->try_take(&item)) {
+                    stamp wait_start = now_ns();
+                    size_t taken = stage.in->take_batch(&item, 1);
+                    bump(c.starved_ns, now_ns() - wait_start);
+                    if (taken == 0) {
+                        break;      // upstream is finished and the buffer is drained
+                    }
+                    bump(c.starved, 1L);
+                }
+                stage.transform(item);
+            }
+            if (stage.out && !stage.out->try_put(item)) {
+                stamp wait_start = now_ns();
+                stage.out->put(item);
+                bump(c.blocked, 1L);
+                bump(c.blocked_ns, now_ns() - wait_start);
+            }
+            bump(c.items, 1L);
+        }
+        if (--stage.running == 0 && stage.out) {
+            stage.out->close();     // the last worker of the stage tells the next stage
+        }
+        return NULL;
+    }
+
+    // PURPOSE: samples how full every input buffer is, once a millisecond, until wait() ends.
+    static void *run_monitor(void *param) {
+        Pipeline *p = (Pipeline *)param;
+        while (!p->done) {
+            for (auto& stage : p->stages) {
+                if (stage->in) {
+                    size_t size = stage->in->ring().size();
+                    bump(stage->occupancy_sum, (long)size);
+                    if (size > stage->occupancy_max.load(std::memory_order_relaxed)) {
+                        stage->occupancy_max.store(size, std::memory_order_relaxed);
+                    }
+                    bump(stage->samples, 1L);
+                }
+            }
+            usleep(1000);
+        }
+        return NULL;
+    }
+
+    const size_t capacity;
+    bool rejected;              // a stage was refused, so start() fails
+    std::vector<std::unique_ptr<Stage>> stages;
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    std::vector<pthread_t> threads;
+    pthread_t monitor;
+    std::atomic<bool> done;
+    stamp start_ns;
+    stamp end_ns;
+};
@@ -0,0 +1,105 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: pipeline_demo.cpp - ingest -> parse -> write pipeline
+// ===========================================================================
+// Build: g++ -O2 -pthread pipeline_demo.cpp -o pipeline_demo
+// Usage: ./pipeline_demo [-i items] [-w ingest,parse,write] [-t ingest,parse,write] [-s capacity]
+//
+// Runs `items` records (default 200000) through three stages with -w workers each (default
+// 1,2,1), where each stage spends -t microseconds of CPU per record (default 1,4,1), then
+// prints the per-stage counters of the Pipeline. Make one stage slower or give it fewer
+// workers and it shows up as the bottleneck: its input buffer is full, the stages before it
+// are blocked and the stages after it are starved.
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <atomic>
+#include <iostream>
+#include "pipeline.h"
+
+// One record moving through the pipeline
+struct Record {
+    long id;
+    long value;
+};
+
+// PURPOSE: keeps the CPU busy for a while, standing in for the real work of a stage.
+// PARAMETER: us = microseconds.
+void work(double us) {
+    stamp until = now_ns() + (stamp)(us * 1000);
+    while (now_ns() < until) {
+    }
+}
+
+// PURPOSE: parses "a,b,c" into three numbers.
+// RETURN: True = if there were three numbers, all >= minimum. False otherwise.
+bool parse_three(const char *text, double out[3], double minimum) {
+    return sscanf(text, "%lf,%lf,%lf", &out[0], &out[1], &out[2]) == 3 &&
+           out[0] >= minimum && out[1] >= minimum && out[2] >= minimum;
+}
+
+int main(int argc, char *argv[])
+{
+    long items = 200000;
+    double workers[3] = {1, 2, 1};
+    double cost_us[3] = {1, 4, 1};
+    size_t capacity = 256;
+    int opt;
+    while ((opt = getopt(argc, argv, "i:w:t:s:")) != -1) {
+        bool ok = true;
+        if (opt == 'i') {
+            ok = (items = atol(optarg)) > 0;
+        } else if (opt == 'w') {
+            ok = parse_three(optarg, workers, 1);
+        } else if (opt == 't') {
+            ok = parse_three(optarg, cost_us, 0);
+        } else if (opt == 's') {
+            ok = (capacity = atol(optarg)) > 0;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cout << "Usage: ./pipeline_demo [-i items] [-w ingest,parse,write] [-t ingest,parse,write] [-s capacity]"
+                      << std::endl;
+            exit(1);
+        }
+    }
+
+    std::atomic<long> next_id(0);
+    std::atomic<long> checksum(0);
+    Pipeline<Record> pipeline(capacity);
+    pipeline.add_source("ingest", (int)workers[0], [&](int, Record *record) {
+        long id = next_id.fetch_add(1, std::memory_order_relaxed);
+        if (id >= items) {
+            return false;
+        }
+        work(cost_us[0]);
+        *record = Record{id, 0};
+        return true;
+    });
+    pipeline.add_stage("parse", (int)workers[1], [&](Record& record) {
+        work(cost_us[1]);
+        record.value = record.id % 1000;
+    });
+    pipeline.add_stage("write", (int)workers[2], [&](Record& record) {
+        work(cost_us[2]);
+        checksum.fetch_add(record.value, std::memory_order_relaxed);
+    });
+
+    std::cout << "items: " << items << ", capacity: " << capacity << ", CPUs: "
+              << sysconf(_SC_NPROCESSORS_ONLN) << "\n";
+    if (!pipeline.start()) {
+        exit(1);
+    }
+    pipeline.wait();
+
+    long expected = (items / 1000) * (999 * 1000 / 2) + (items % 1000) * (items % 1000 - 1) / 2;
+    std::cout << std::fixed << std::setprecision(3) << items / pipeline.seconds() / 1e6
+              << " Mrecords/s in " << pipeline.seconds() << " s"
+              << (checksum == expected ? "" : "  CHECKSUM MISMATCH") << "\n";
+    pipeline.report(std::cout);
+    return 0;
+}
@@ -0,0 +1,179 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: priority_buffer.h - header file (lock-free priority classes)
+// ===========================================================================
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "ring_buffer.h"
+
+// An item tagged with its priority class; class 0 is served first
+template <typename T>
+struct Prioritized {
+    unsigned priority;
+    T item;
+};
+
+// ===========================================================================
+// Bounded buffer with priority classes: one MPMCRing per class, so items of a
+// class stay FIFO and no lock is taken. Bit c of `occupied` says class c may
+// have items; a consumer finds the most urgent class with one load and a
+// count-trailing-zeros instead of trying every ring.
+// Bounded starvation: removals that skip a waiting lower class are counted,
+// and every StarvationLimit-th such removal serves a lower class instead,
+// taking the waiting classes in turn. A non-empty class is therefore served
+// within about StarvationLimit * (Classes - 1) removals, however much urgent
+// traffic keeps arriving.
+// value_type is Prioritized<T>, so BlockingRing works on it unchanged. Each
+// class holds `capacity` items; a full class fails the insert even if others
+// have room, so bulk data can't crowd out control messages.
+// ===========================================================================
+template <typename T, unsigned Classes = 4, unsigned StarvationLimit = 16>
+class PriorityRing {
+    static_assert(Classes >= 1 && Classes <= 32, "one bit per class in a 32-bit word");
+
+public:
+    typedef Prioritized<T> value_type;
+
+    // PURPOSE: creates an empty buffer.
+    // PARAMETER: capacity = items each class holds, rounded up to a power of two.
+    explicit PriorityRing(size_t capacity) : occupied(0), bypassed(0), rotor(0) {
+        for (unsigned c = 0; c < Classes; c++) {
+            rings[c].reset(new MPMCRing<T>(capacity));
+        }
+    }
+
+    // PURPOSE: inserts an item at the back of its class; classes past the last count as the last.
+    // PARAMETER: tagged = the item and its class.
+    // RETURN: 0 = if insert was successful. -1 = if the item's class is full.
+    int insert_item(const value_type& tagged) {
+        unsigned c = tagged.priority < Classes ? tagged.priority : Classes - 1;
+        if (rings[c]->insert_item(tagged.item) != 0) {
+            return -1;
+        }
+        // After the insert: a consumer that clears the bit either runs after this and sees the
+        // bit, or before it and then sees the item when it checks the ring again
+        occupied.fetch_or(1u << c, std::memory_order_seq_cst);
+        return 0;
+    }
+
+    // PURPOSE: removes the front item of the most urgent non-empty class, or of a starved one.
+    // PARAMETER: *tagged = receives the item and its class.
+    // RETURN: 0 = if remove was successful. -1 = if every class is empty.
+    int remove_item(value_type *tagged) {
+        uint32_t occ = occupied.load(std::memory_order_seq_cst);
+        if (occ == 0) {
+            occ = rescan();
+            if (occ == 0) {
+                return -1;
+            }
+        }
+
+        unsigned first = __builtin_ctz(occ);
+        uint32_t lower = occ & ~(1u << first);      // classes this removal would skip
+        if (lower != 0 && bypassed.fetch_add(1, std::memory_order_relaxed) + 1 >= StarvationLimit) {
+            bypassed.store(0, std::memory_order_relaxed);
+            while (lower != 0) {
+                unsigned c = next_starved(lower);
+                if (take(c, tagged)) {
+                    return 0;
+                }
+                lower &= ~(1u << c);       // its bit was stale: try the next waiting class
+            }
+        }
+
+        // Most urgent class first; a bit can be stale, so fall through to the next one
+        while (occ != 0) {
+            unsigned c = __builtin_ctz(occ);
+            if (take(c, tagged)) {
+                return 0;
+            }
+            occ &= occ - 1;
+        }
+        return -1;
+    }
+
+    // PURPOSE: inserts up to n items, one at a time.
+    // RETURN: the number of items inserted, fewer than n when a class fills up.
+    size_t insert_batch(const value_type *src, size_t n) {
+        size_t count = 0;
+        while (count < n && insert_item(src[count]) == 0) {
+            count++;
+        }
+        return count;
+    }
+
+    // PURPOSE: removes up to max items, one at a time, in priority order.
+    // RETURN: the number of items removed, 0 if every class is empty.
+    size_t remove_batch(value_type *dst, size_t max) {
+        size_t count = 0;
+        while (count < max && remove_item(&dst[count]) == 0) {
+            count++;
+        }
+        return count;
+    }
+
+    // RETURN: the number of items all classes hold together.
+    size_t capacity() const { return rings[0]->capacity() * Classes; }
+
+    // RETURN: the number of items in all classes; only a snapshot while other threads run.
+    size_t size() const {
+        size_t total = 0;
+        for (unsigned c = 0; c < Classes; c++) {
+            total += rings[c]->size();
+        }
+        return total;
+    }
+
+    // RETURN: the number of items in class c; only a snapshot while other threads run.
+    size_t size(unsigned c) const { return rings[c < Classes ? c : Classes - 1]->size(); }
+
+private:
+    // PURPOSE: removes from class c; if it is empty, clears its bit, then sets it again if an
+    //          insert got in between (see insert_item).
+    // RETURN: True = if an item was removed. False otherwise.
+    bool take(unsigned c, value_type *tagged) {
+        if (rings[c]->remove_item(&tagged->item) == 0) {
+            tagged->priority = c;
+            return true;
+        }
+        occupied.fetch_and(~(1u << c), std::memory_order_seq_cst);
+        if (rings[c]->size() > 0) {
+            occupied.fetch_or(1u << c, std::memory_order_seq_cst);
+        }
+        return false;
+    }
+
+    // PURPOSE: sets the bit of every class that has items. Called when no bit is set, so a
+    //          consumer can't report the buffer empty while another one briefly cleared a bit.
+    // RETURN: the bitmap afterwards.
+    uint32_t rescan() {
+        for (unsigned c = 0; c < Classes; c++) {
+            if (rings[c]->size() > 0) {
+                occupied.fetch_or(1u << c, std::memory_order_seq_cst);
+            }
+        }
+        return occupied.load(std::memory_order_seq_cst);
+    }
+
+    // PURPOSE: picks the waiting class after the one served by the last forced removal.
+    // PARAMETER: waiting = bitmap of the skipped classes, not 0.
+    // RETURN: the class to serve.
+    unsigned next_starved(uint32_t waiting) {
+        unsigned last = rotor.load(std::memory_order_relaxed);
+        uint32_t after = last + 1 < 32 ? waiting & (~0u << (last + 1)) : 0;
+        unsigned c = __builtin_ctz(after != 0 ? after : waiting);     // wrap around
+        rotor.store(c, std::memory_order_relaxed);
+        return c;
+    }
+
+    std::unique_ptr<MPMCRing<T>> rings[Classes];
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> occupied;    // bit c: class c may have items
+    alignas(CACHE_LINE_SIZE) std::atomic<unsigned> bypassed;    // removals that skipped a lower class
+    std::atomic<unsigned> rotor;                                // class of the last forced removal
+};
@@ -0,0 +1,257 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: ring_buffer.h - header file (lock-free bounded buffers)
+// ===========================================================================
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "buffer.h"
+
+#define CACHE_LINE_SIZE 64      // bytes per cache line on x86-64 and most ARM cores
+
+// ===========================================================================
+// Bounded multi-producer multi-consumer ring (Dmitry Vyukov's design).
+// Every slot carries a sequence number saying whose turn it is: a producer may
+// fill slot pos when its sequence is pos, a consumer may empty it when it is
+// pos + 1. An insert or remove is one CAS on the shared position plus a store
+// to the slot, so no thread ever holds a lock another one waits for.
+// insert_item/remove_item keep buffer.cpp's semantics: 0 on success, -1 when
+// the ring is full/empty, and they never block.
+// ===========================================================================
+template <typename T>
+class MPMCRing {
+public:
+    typedef T value_type;
+
+    // PURPOSE: creates an empty ring.
+    // PARAMETER: capacity = number of items it holds, rounded up to a power of two.
+    explicit MPMCRing(size_t capacity)
+        : mask(round_up_pow2(capacity) - 1), cells(new Cell[mask + 1]),
+          enqueue_pos(0), dequeue_pos(0)
+    {
+        for (size_t i = 0; i <= mask; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // PURPOSE: inserts an item at the back of the ring.
+    // PARAMETER: item = the item to insert.
+    // RETURN: 0 = if insert was successful. -1 = if the ring is full.
+    int insert_item(const T& item) {
+        Cell *cell;
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                // The slot is free for this position: claim the position
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return -1;      // the slot still holds the item from one lap ago
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);     // another producer won
+            }
+        }
+        cell->data = item;
+        cell->sequence.store(pos + 1, std::memory_order_release);  // hand the slot to consumers
+        return 0;
+    }
+
+    // PURPOSE: removes the item at the front of the ring.
+    // PARAMETER: *item = receives the removed item.
+    // RETURN: 0 = if remove was successful. -1 = if the ring is empty.
+    int remove_item(T *item) {
+        Cell *cell;
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return -1;      // no producer has filled this position yet
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);     // another consumer won
+            }
+        }
+        *item = cell->data;
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);   // free it for the next lap
+        return 0;
+    }
+
+    // PURPOSE: inserts up to n items, one CAS each. Unlike SPSCRing a range can't be claimed at
+    //          once: consumers free slots out of order, so one sequence check can't vouch for
+    //          the slots before it.
+    // PARAMETER: src = the items to insert. n = how many.
+    // RETURN: the number of items inserted, fewer than n when the ring fills up.
+    size_t insert_batch(const T *src, size_t n) {
+        size_t count = 0;
+        while (count < n && insert_item(src[count]) == 0) {
+            count++;
+        }
+        return count;
+    }
+
+    // PURPOSE: removes up to max items, one CAS each.
+    // PARAMETER: dst = receives the removed items. max = room in dst.
+    // RETURN: the number of items removed, 0 if the ring is empty.
+    size_t remove_batch(T *dst, size_t max) {
+        size_t count = 0;
+        while (count < max && remove_item(&dst[count]) == 0) {
+            count++;
+        }
+        return count;
+    }
+
+    // RETURN: the number of items the ring holds.
+    size_t capacity() const { return mask + 1; }
+
+    // RETURN: the number of items in the ring; only a snapshot while other threads run.
+    size_t size() const {
+        size_t back = enqueue_pos.load(std::memory_order_acquire);
+        size_t front = dequeue_pos.load(std::memory_order_acquire);
+        return back > front ? back - front : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    const size_t mask;                  // capacity - 1
+    std::unique_ptr<Cell[]> cells;
+
+    // Producers and consumers each hammer their own position, so keep them on separate lines
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueue_pos;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeue_pos;
+};
+
+// ===========================================================================
+// Bounded single-producer single-consumer ring (Lamport's queue).
+// Only the producer writes back and only the consumer writes front, so no CAS
+// is needed: each side publishes its position with a release store and reads
+// the other side's with an acquire load. Positions run freely and are masked
+// on use, so the ring is full when back - front == capacity; there is no count
+// that both sides would have to write.
+// Layout: the producer's index and the consumer's index each own a cache line,
+// and each side keeps a private copy of the other side's index next to its own.
+// The copy is only refreshed when the ring looks full (producer) or empty
+// (consumer), so while the ring is neither, a side touches only its own line
+// and the slots, and the lines never bounce between cores.
+// Exactly one thread may insert and exactly one may remove. The batch calls
+// move a whole range with a single synchronization per side.
+// ===========================================================================
+template <typename T>
+class SPSCRing {
+public:
+    typedef T value_type;
+
+    // PURPOSE: creates an empty ring.
+    // PARAMETER: capacity = number of items it holds, rounded up to a power of two.
+    explicit SPSCRing(size_t capacity)
+        : mask(round_up_pow2(capacity) - 1), items(new T[mask + 1]()),
+          back(0), cached_front(0), front(0), cached_back(0)
+    {
+    }
+
+    // PURPOSE: inserts an item at the back of the ring; producer thread only.
+    // PARAMETER: item = the item to insert.
+    // RETURN: 0 = if insert was successful. -1 = if the ring is full.
+    int insert_item(const T& item) {
+        size_t b = back.load(std::memory_order_relaxed);
+        if (b - cached_front > mask) {
+            cached_front = front.load(std::memory_order_acquire);
+            if (b - cached_front > mask) {
+                return -1;
+            }
+        }
+        items[b & mask] = item;
+        back.store(b + 1, std::memory_order_release);
+        return 0;
+    }
+
+    // PURPOSE: removes the item at the front of the ring; consumer thread only.
+    // PARAMETER: *item = receives the removed item.
+    // RETURN: 0 = if remove was successful. -1 = if the ring is empty.
+    int remove_item(T *item) {
+        size_t f = front.load(std::memory_order_relaxed);
+        if (f == cached_back) {
+            cached_back = back.load(std::memory_order_acquire);
+            if (f == cached_back) {
+                return -1;
+            }
+        }
+        *item = items[f & mask];
+        front.store(f + 1, std::memory_order_release);
+        return 0;
+    }
+
+    // PURPOSE: inserts up to n items; producer thread only. The free range is claimed at once,
+    //          filled with one or two copies, and published with one release store.
+    // PARAMETER: src = the items to insert. n = how many.
+    // RETURN: the number of items inserted, 0 if the ring is full.
+    size_t insert_batch(const T *src, size_t n) {
+        size_t b = back.load(std::memory_order_relaxed);
+        if (mask + 1 - (b - cached_front) < n) {
+            cached_front = front.load(std::memory_order_acquire);
+        }
+        size_t count = std::min(n, mask + 1 - (b - cached_front));
+        size_t start = b & mask;
+        size_t first = std::min(count, mask + 1 - start);      // part before the wrap
+        copy_items(&items[start], src, first);
+        copy_items(&items[0], src + first, count - first);
+        back.store(b + count, std::memory_order_release);
+        return count;
+    }
+
+    // PURPOSE: removes up to max items; consumer thread only.
+    // PARAMETER: dst = receives the removed items, front first. max = room in dst.
+    // RETURN: the number of items removed, 0 if the ring is empty.
+    size_t remove_batch(T *dst, size_t max) {
+        size_t f = front.load(std::memory_order_relaxed);
+        if (cached_back - f < max) {
+            cached_back = back.load(std::memory_order_acquire);
+        }
+        size_t count = std::min(max, cached_back - f);
+        size_t start = f & mask;
+        size_t first = std::min(count, mask + 1 - start);
+        copy_items(dst, &items[start], first);
+        copy_items(dst + first, &items[0], count - first);
+        front.store(f + count, std::memory_order_release);
+        return count;
+    }
+
+    // RETURN: the number of items the ring holds.
+    size_t capacity() const { return mask + 1; }
+
+    // RETURN: the number of items in the ring; only a snapshot while other threads run.
+    size_t size() const {
+        size_t f = front.load(std::memory_order_acquire);
+        return back.load(std::memory_order_acquire) - f;
+    }
+
+private:
+    // Read-only after construction, shared by both sides
+    const size_t mask;                  // capacity - 1
+    std::unique_ptr<T[]> items;
+
+    // Producer's line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> back;     // next position to fill
+    size_t cached_front;                                    // last front the producer saw
+
+    // Consumer's line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> front;    // next position to remove
+    size_t cached_back;                                     // last back the consumer saw
+};
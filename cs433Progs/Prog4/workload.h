@@ -0,0 +1,126 @@
+// ===========================================================================
+// Name: Oscar Lopez
+// Date: 04/10/25
+// Course: CS433 - Operating Systems Section 1
+// Assignment: 4 - Multi-threaded Programing for the Producer-Consumer Problem
+// File type: workload.h - header file (random numbers, think times, timestamps)
+// ===========================================================================
+// rand() shares one hidden state between all threads, so it is neither thread-safe nor
+// cheap to call from many of them. Every thread owns an Rng instead. A ThinkTime says how
+// long a thread works between two buffer operations: not at all, a fixed time, or an
+// exponentially distributed time with a given mean (a Poisson arrival process).
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <cmath>
+
+typedef long long stamp;        // nanoseconds on CLOCK_MONOTONIC
+
+// PURPOSE: reads the monotonic clock.
+// RETURN: nanoseconds.
+inline stamp now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// ===========================================================================
+// Per-thread pseudo-random numbers (xorshift64*, seeded through splitmix64 so
+// that nearby seeds such as thread numbers give unrelated sequences).
+// ===========================================================================
+class Rng {
+public:
+    // PARAMETER: seed = any value; give every thread a different one.
+    explicit Rng(uint64_t seed) {
+        uint64_t z = seed + 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        state = (z ^ (z >> 31)) | 1;        // xorshift must not start at 0
+    }
+
+    // RETURN: the next 64 random bits.
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545f4914f6cdd1dULL;
+    }
+
+    // RETURN: a number in [0, n).
+    uint64_t below(uint64_t n) { return next() % n; }
+
+    // RETURN: a number in [0, 1).
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+private:
+    uint64_t state;
+};
+
+// ===========================================================================
+// Think time between two buffer operations
+// ===========================================================================
+enum ThinkKind { THINK_ZERO, THINK_FIXED, THINK_EXPONENTIAL };
+
+struct ThinkTime {
+    ThinkKind kind;
+    double mean_us;             // the fixed time, or the mean of the exponential
+
+    // PURPOSE: draws one think time.
+    // PARAMETER: rng = the calling thread's Rng.
+    // RETURN: microseconds.
+    double sample_us(Rng& rng) const {
+        if (kind == THINK_FIXED) {
+            return mean_us;
+        } else if (kind == THINK_EXPONENTIAL) {
+            return -mean_us * std::log(1.0 - rng.uniform());
+        }
+        return 0;
+    }
+
+    // PURPOSE: thinks for one sampled time. Spans under 50 us spin on the clock, since a sleep
+    //          that short mostly measures the timer slack; longer ones sleep.
+    // PARAMETER: rng = the calling thread's Rng.
+    void think(Rng& rng) const {
+        double us = sample_us(rng);
+        if (us <= 0) {
+            return;
+        }
+        stamp until = now_ns() + (stamp)(us * 1000);
+        if (us < 50) {
+            while (now_ns() < until) {
+            }
+            return;
+        }
+        struct timespec ts = {(time_t)(until / 1000000000LL), (long)(until % 1000000000LL)};
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+    }
+};
+
+// PURPOSE: parses a think time: "0", "fixed:US" or "exp:US", with US in microseconds.
+// PARAMETER: text = the text to parse. *think = receives the think time.
+// RETURN: True = if the text was valid. False otherwise.
+inline bool parse_think_time(const char *text, ThinkTime *think) {
+    const char *colon = strchr(text, ':');
+    if (colon == NULL) {
+        if (strcmp(text, "0") != 0 && strcmp(text, "zero") != 0) {
+            return false;
+        }
+        *think = ThinkTime{THINK_ZERO, 0};
+        return true;
+    }
+    char *end;
+    double us = strtod(colon + 1, &end);
+    if (*end != '\0' || us < 0) {
+        return false;
+    }
+    if (strncmp(text, "fixed:", colon - text + 1) == 0) {
+        *think = ThinkTime{THINK_FIXED, us};
+    } else if (strncmp(text, "exp:", colon - text + 1) == 0) {
+        *think = ThinkTime{THINK_EXPONENTIAL, us};
+    } else {
+        return false;
+    }
+    return true;
+}
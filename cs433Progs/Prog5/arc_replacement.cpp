@@ -0,0 +1,107 @@
+/**
+ * Assignment 5: Page replacement algorithms
+ * @file arc_replacement.cpp
+ * @author Oscar Lopez
+ * @brief Implementation of the ARC page replacement algorithm
+ * @version 0.1
+ */
+
+#include "arc_replacement.h"
+#include <algorithm>
+
+ARCReplacement::ARCReplacement(int num_pages, int num_frames)
+: Replacement(num_pages, num_frames), lists(num_pages, NUM_LISTS), target_t1(0), last_victim(-1)
+{
+}
+
+ARCReplacement::~ARCReplacement() {
+    // The lists free themselves
+}
+
+void ARCReplacement::evict(int page_num, int ghost_list) {
+    release_frame(page_table[page_num].frame_num);
+    page_table[page_num].valid = false;
+    page_table[page_num].frame_num = -1;
+    if (ghost_list != -1) {
+        lists.push_front(ghost_list, page_num);
+    }
+    last_victim = page_num;
+}
+
+void ARCReplacement::make_room(bool hit_in_b2) {
+    int t1 = lists.size(T1);
+    // REPLACE(x, p) from the paper; also falls back to T1 when T2 is empty
+    if (t1 > 0 && (t1 > target_t1 || (hit_in_b2 && t1 == target_t1) || lists.size(T2) == 0)) {
+        evict(lists.pop_back(T1), B1);
+    } else {
+        evict(lists.pop_back(T2), B2);
+    }
+}
+
+void ARCReplacement::admit(int page_num, bool full) {
+    int list = lists.list_of(page_num);
+
+    if (list == B1) {
+        // T1 was evicting too early: give it more room
+        int delta = std::max(1, lists.size(B2) / lists.size(B1));
+        target_t1 = std::min(num_frames, target_t1 + delta);
+        lists.remove(page_num);
+        if (full) {
+            make_room(false);
+        }
+        lists.push_front(T2, page_num);
+    } else if (list == B2) {
+        // T2 was evicting too early: give it more room
+        int delta = std::max(1, lists.size(B1) / lists.size(B2));
+        target_t1 = std::max(0, target_t1 - delta);
+        lists.remove(page_num);
+        if (full) {
+            make_room(true);
+        }
+        lists.push_front(T2, page_num);
+    } else {
+        // Not remembered at all: keep the ghost lists within 2 * num_frames entries
+        int l1 = lists.size(T1) + lists.size(B1);
+        int total = l1 + lists.size(T2) + lists.size(B2);
+        if (l1 == num_frames) {
+            if (lists.size(T1) < num_frames) {
+                lists.pop_back(B1);
+                if (full) {
+                    make_room(false);
+                }
+            } else {
+                // T1 alone fills memory: drop its oldest page without a ghost
+                evict(lists.pop_back(T1), -1);
+            }
+        } else {
+            if (total >= 2 * num_frames) {
+                lists.pop_back(B2);
+            }
+            if (full) {
+                make_room(false);
+            }
+        }
+        lists.push_front(T1, page_num);
+    }
+    page_table[page_num].referenced = true;
+}
+
+void ARCReplacement::touch_page(int page_num) {
+    // A second reference makes the page frequent
+    lists.remove(page_num);
+    lists.push_front(T2, page_num);
+    page_table[page_num].referenced = true;
+}
+
+void ARCReplacement::load_page(int page_num) {
+    admit(page_num, false);
+}
+
+int ARCReplacement::replace_page(int page_num) {
+    admit(page_num, true);
+    // admit() evicted a page, so a frame is free again
+    page_table[page_num].frame_num = find_free_frame();
+    page_table[page_num].valid = true;
+    page_replacements++;
+    return last_victim;
+}
@@ -0,0 +1,92 @@
+/**
+ * Assignment 5: Page replacement algorithms
+ * @file arc_replacement.h
+ * @author Oscar Lopez
+ * @brief A class implementing the ARC (Adaptive Replacement Cache) page replacement algorithm
+ * @version 0.1
+ *
+ * ARC (Megiddo and Modha, FAST 2003) splits the resident pages into two LRU lists: T1 holds
+ * pages seen once recently, T2 pages seen at least twice. A scan only passes through T1, so
+ * it can't flush the hot set in T2. Two ghost lists, B1 and B2, remember the pages recently
+ * evicted from T1 and T2. A fault on a ghost shows which list was too small, and the target
+ * size p of T1 moves towards it, so the split between recency and frequency adapts to the
+ * workload. Together the four lists remember at most 2 * num_frames pages.
+ */
+
+#pragma once
+
+#include "replacement.h"
+#include "page_lists.h"
+
+/**
+ * @brief A class to simulate the ARC page replacement algorithm.
+ */
+class ARCReplacement : public Replacement {
+private:
+    // The lists in `lists`
+    enum {
+        T1,         // resident, seen once recently
+        T2,         // resident, seen at least twice recently
+        B1,         // ghosts evicted from T1
+        B2,         // ghosts evicted from T2
+        NUM_LISTS
+    };
+
+    PageLists lists;
+    // Target size of T1
+    int target_t1;
+    // The page evicted by the last fault
+    int last_victim;
+
+    /**
+     * @brief Evict a resident page, making it a ghost on the given list.
+     * @param page_num The logical page number, already removed from T1 or T2.
+     * @param ghost_list B1 or B2, or -1 to forget the page.
+     */
+    void evict(int page_num, int ghost_list);
+
+    /**
+     * @brief Evict the back of T1 or of T2, whichever is over its share.
+     * @param hit_in_b2 Whether the faulting page was a ghost in B2.
+     */
+    void make_room(bool hit_in_b2);
+
+    /**
+     * @brief Adapt the lists for a faulted page and put it on T1 or T2.
+     * @param page_num The logical page number.
+     * @param full Whether every frame is in use, so a page must be evicted first.
+     */
+    void admit(int page_num, bool full);
+
+public:
+    /**
+     * @brief Constructor
+     * @param num_pages Total number of logical pages.
+     * @param num_frames Total number of physical frames.
+     */
+    ARCReplacement(int num_pages, int num_frames);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~ARCReplacement();
+
+    /**
+     * @brief Access a page already in memory: move it to the front of T2.
+     * @param page_num The logical page number.
+     */
+    virtual void touch_page(int page_num);
+
+    /**
+     * @brief Put a page just loaded into a free frame on T1 or T2.
+     * @param page_num The logical page number.
+     */
+    virtual void load_page(int page_num);
+
+    /**
+     * @brief Evict a page from T1 or T2 and load the new page in its frame.
+     * @param page_num The logical page number of the desired page.
+     * @return Selected victim page #
+     */
+    virtual int replace_page(int page_num);
+};
@@ -0,0 +1,175 @@
+/**
+ * Assignment 5: Page replacement algorithms
+ * @file clock_pro_replacement.cpp
+ * @author Oscar Lopez
+ * @brief Implementation of the CLOCK-Pro page replacement algorithm
+ * @version 0.1
+ */
+
+#include "clock_pro_replacement.h"
+
+ClockProReplacement::ClockProReplacement(int num_pages, int num_frames)
+: Replacement(num_pages, num_frames),
+  prev_page(num_pages, -1), next_page(num_pages, -1), entry_type(num_pages, NOT_IN_CLOCK),
+  hand_hot(-1), hand_cold(-1), hand_test(-1), count_hot(0), count_cold(0), count_test(0),
+  cold_target(num_frames), last_victim(-1)
+{
+}
+
+ClockProReplacement::~ClockProReplacement() {
+    // The vectors free themselves
+}
+
+void ClockProReplacement::link(int page_num) {
+    if (hand_hot == -1) {
+        // First entry: a circle of one, with every hand on it
+        prev_page[page_num] = next_page[page_num] = page_num;
+        hand_hot = hand_cold = hand_test = page_num;
+        return;
+    }
+    int before = prev_page[hand_hot];
+    next_page[before] = page_num;
+    prev_page[page_num] = before;
+    next_page[page_num] = hand_hot;
+    prev_page[hand_hot] = page_num;
+    if (hand_cold == hand_hot) {
+        hand_cold = page_num;
+    }
+}
+
+void ClockProReplacement::unlink(int page_num) {
+    if (next_page[page_num] == page_num) {
+        hand_hot = hand_cold = hand_test = -1;      // it was the only entry
+    } else {
+        int prev = prev_page[page_num];
+        int next = next_page[page_num];
+        if (hand_hot == page_num) {
+            hand_hot = prev;
+        }
+        if (hand_cold == page_num) {
+            hand_cold = prev;
+        }
+        if (hand_test == page_num) {
+            hand_test = prev;
+        }
+        next_page[prev] = next;
+        prev_page[next] = prev;
+    }
+    prev_page[page_num] = next_page[page_num] = -1;
+}
+
+void ClockProReplacement::run_hand_cold() {
+    int page = hand_cold;
+    if (entry_type[page] == COLD) {
+        if (page_table[page].referenced) {
+            // Reused during its test period: short reuse distance, promote it
+            entry_type[page] = HOT;
+            page_table[page].referenced = false;
+            count_cold--;
+            count_hot++;
+        } else {
+            // Evict it, but remember it as a test entry
+            entry_type[page] = TEST;
+            release_frame(page_table[page].frame_num);
+            page_table[page].valid = false;
+            page_table[page].frame_num = -1;
+            last_victim = page;
+            count_cold--;
+            count_test++;
+        }
+    }
+    hand_cold = next_page[hand_cold];
+}
+
+void ClockProReplacement::run_hand_hot() {
+    if (hand_hot == hand_test) {
+        run_hand_test();
+    }
+    int page = hand_hot;
+    if (entry_type[page] == HOT) {
+        if (page_table[page].referenced) {
+            page_table[page].referenced = false;
+        } else {
+            entry_type[page] = COLD;
+            count_hot--;
+            count_cold++;
+        }
+    }
+    hand_hot = next_page[hand_hot];
+}
+
+void ClockProReplacement::run_hand_test() {
+    if (hand_test == hand_cold) {
+        run_hand_cold();
+    }
+    int page = hand_test;
+    if (entry_type[page] == TEST) {
+        // Its test period ends without a reuse: forget it, and want fewer cold pages
+        unlink(page);                   // moves hand_test back one entry
+        entry_type[page] = NOT_IN_CLOCK;
+        count_test--;
+        if (cold_target > 1) {
+            cold_target--;
+        }
+    }
+    hand_test = next_page[hand_test];
+}
+
+void ClockProReplacement::make_room() {
+    // Each hand only ever runs another one a single step ahead (hot -> test -> cold), so the
+    // hands call each other at most two deep; the loops that keep them going live here
+    while (count_hot + count_cold >= num_frames) {
+        // Each cold hand step either evicts a cold page or promotes one
+        run_hand_cold();
+        // Every step of these either removes a test entry, demotes a hot page or clears its
+        // referenced bit, so both loops end within two turns of the clock
+        while (count_test > num_frames) {
+            run_hand_test();
+        }
+        while (count_hot > num_frames - cold_target) {
+            run_hand_hot();
+        }
+    }
+}
+
+void ClockProReplacement::admit(int page_num) {
+    bool was_test = entry_type[page_num] == TEST;
+    if (was_test) {
+        // Faulted again while remembered: cold pages deserve a longer test period
+        if (cold_target < num_frames) {
+            cold_target++;
+        }
+        unlink(page_num);
+        entry_type[page_num] = NOT_IN_CLOCK;
+        count_test--;
+    }
+
+    make_room();
+
+    link(page_num);
+    if (was_test) {
+        entry_type[page_num] = HOT;
+        count_hot++;
+    } else {
+        entry_type[page_num] = COLD;
+        count_cold++;
+    }
+    page_table[page_num].referenced = false;
+}
+
+void ClockProReplacement::touch_page(int page_num) {
+    page_table[page_num].referenced = true;
+}
+
+void ClockProReplacement::load_page(int page_num) {
+    admit(page_num);
+}
+
+int ClockProReplacement::replace_page(int page_num) {
+    admit(page_num);
+    // The cold hand evicted a page, so a frame is free again
+    page_table[page_num].frame_num = find_free_frame();
+    page_table[page_num].valid = true;
+    page_replacements++;
+    return last_victim;
+}
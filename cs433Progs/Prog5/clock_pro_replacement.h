@@ -0,0 +1,129 @@
+/**
+ * Assignment 5: Page replacement algorithms
+ * @file clock_pro_replacement.h
+ * @author Oscar Lopez
+ * @brief A class implementing the CLOCK-Pro page replacement algorithm
+ * @version 0.1
+ *
+ * CLOCK-Pro (Jiang, Chen and Zhang, USENIX 2005) keeps CLOCK's cheap hits but decides by
+ * reuse distance instead of recency, so a one-time scan can't flush the pages that are
+ * used again and again. Resident pages are hot or cold; only cold pages are evicted. An
+ * evicted cold page stays in the clock for a while as a non-resident "test" entry: if it
+ * is faulted in again during that test period, its reuse distance is short and it comes
+ * back hot. Three hands sweep one circular list that holds all of these entries:
+ * - the cold hand evicts cold pages, or promotes a cold page whose referenced bit is set
+ * - the hot hand demotes hot pages that weren't referenced since it last passed
+ * - the test hand ends test periods, dropping non-resident entries
+ * The number of cold pages adapts: it grows when a test entry is hit (cold pages needed more
+ * time to prove themselves) and shrinks when a test period ends unused. This follows the
+ * authors' reference implementation, in which every resident cold page is in its test period.
+ */
+
+#pragma once
+
+#include "replacement.h"
+#include <vector>
+
+/**
+ * @brief A class to simulate the CLOCK-Pro page replacement algorithm.
+ */
+class ClockProReplacement : public Replacement {
+private:
+    // What a page's clock entry is
+    enum EntryType : unsigned char {
+        NOT_IN_CLOCK,       // no entry
+        HOT,                // resident, frequently reused
+        COLD,               // resident, on probation
+        TEST                // not resident, still remembered from its test period
+    };
+
+    // The circular list, linked by page number; -1 = not in the list
+    std::vector<int> prev_page;
+    std::vector<int> next_page;
+    std::vector<EntryType> entry_type;
+    // The three hands, as page numbers; -1 while the clock is empty
+    int hand_hot;
+    int hand_cold;
+    int hand_test;
+    int count_hot;
+    int count_cold;
+    int count_test;
+    // Target number of cold pages; hot pages may use the rest of the frames
+    int cold_target;
+    // The page evicted by the last cold hand sweep
+    int last_victim;
+
+    /**
+     * @brief Insert a page just before the hot hand, i.e. at the head of the clock.
+     * @param page_num The logical page number.
+     */
+    void link(int page_num);
+
+    /**
+     * @brief Remove a page from the clock; a hand pointing at it moves back one entry.
+     * @param page_num The logical page number.
+     */
+    void unlink(int page_num);
+
+    /**
+     * @brief Run the cold hand over one entry, evicting or promoting a cold page.
+     */
+    void run_hand_cold();
+
+    /**
+     * @brief Run the hot hand over one entry, demoting an unreferenced hot page. If it is on
+     *        the test hand's entry, the test hand runs first, so the hot hand pushes it forward.
+     */
+    void run_hand_hot();
+
+    /**
+     * @brief Run the test hand over one entry, ending its test period. If it is on the cold
+     *        hand's entry, the cold hand runs first.
+     */
+    void run_hand_test();
+
+    /**
+     * @brief Run the cold hand until a page is evicted, running the test and hot hands
+     *        whenever too many test or hot entries are left behind.
+     */
+    void make_room();
+
+    /**
+     * @brief Put a faulted page into the clock (hot if it was a test entry, cold otherwise),
+     *        running the cold hand first if every frame is in use.
+     * @param page_num The logical page number.
+     */
+    void admit(int page_num);
+
+public:
+    /**
+     * @brief Constructor
+     * @param num_pages Total number of logical pages.
+     * @param num_frames Total number of physical frames.
+     */
+    ClockProReplacement(int num_pages, int num_frames);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~ClockProReplacement();
+
+    /**
+     * @brief Access a page already in memory: set its referenced bit.
+     * @param page_num The logical page number.
+     */
+    virtual void touch_page(int page_num);
+
+    /**
+     * @brief Put a page just loaded into a free frame into the clock.
+     * @param page_num The logical page number.
+     */
+    virtual void load_page(int page_num);
+
+    /**
+     * @brief Run the cold hand until a cold page is evicted, then load the new page.
+     * @param page_num The logical page number of the desired page.
+     * @return Selected victim page #
+     */
+    virtual int replace_page(int page_num);
+};
@@ -0,0 +1,54 @@
+/**
+ * Assignment 5: Page replacement algorithms
+ * @file clock_replacement.cpp
+ * @author Oscar Lopez
+ * @brief Implementation of the Second-Chance CLOCK page replacement algorithm
+ * @version 0.1
+ */
+
+#include "clock_replacement.h"
+
+ClockReplacement::ClockReplacement(int num_pages, int num_frames)
+: Replacement(num_pages, num_frames), frame_page(num_frames, -1), hand(0)
+{
+}
+
+ClockReplacement::~ClockReplacement() {
+    // The vector frees itself
+}
+
+void ClockReplacement::touch_page(int page_num) {
+    page_table[page_num].referenced = true;
+}
+
+void ClockReplacement::load_page(int page_num) {
+    // Frames are never freed, so Replacement::access_page hands them out in clock order 0, 1, 2...
+    int frame = page_table[page_num].frame_num;
+    // A new page starts without its bit, so it is replaced on the next sweep unless it is used again
+    page_table[page_num].referenced = false;
+    frame_page[frame] = page_num;
+}
+
+int ClockReplacement::replace_page(int page_num) {
+    // Give every referenced page a second chance; stops within one full turn, since the bits
+    // cleared on the way stay clear
+    while (page_table[frame_page[hand]].referenced) {
+        page_table[frame_page[hand]].referenced = false;
+        hand = (hand + 1) % num_frames;
+    }
+
+    int frame = hand;
+    int victim_page = frame_page[frame];
+    page_table[victim_page].valid = false;
+    page_table[victim_page].frame_num = -1;
+
+    page_table[page_num].frame_num = frame;
+    page_table[page_num].valid = true;
+    page_table[page_num].referenced = false;
+    frame_page[frame] = page_num;
+
+    // The new page is the newest in clock order, so the hand moves past it
+    hand = (hand + 1) % num_frames;
+    page_replacements++;
+    return victim_page;
+}
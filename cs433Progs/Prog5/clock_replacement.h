@@ -0,0 +1,62 @@
+/**
+ * Assignment 5: Page replacement algorithms
+ * @file clock_replacement.h
+ * @author Oscar Lopez
+ * @brief A class implementing the Second-Chance CLOCK page replacement algorithm
+ * @version 0.1
+ *
+ * CLOCK approximates LRU with the referenced bit of each page table entry. The frames form
+ * a circle with a hand pointing at the oldest one. A hit only sets the page's referenced
+ * bit. On a fault the hand sweeps forward: a page with the bit set gets a second chance
+ * (the bit is cleared and the hand moves on), and the first page found with the bit clear
+ * is the victim. Hits cost one store instead of LRU's list update.
+ */
+
+#pragma once
+
+#include "replacement.h"
+#include <vector>
+
+/**
+ * @brief A class to simulate the Second-Chance CLOCK page replacement algorithm.
+ */
+class ClockReplacement : public Replacement {
+private:
+    // The page held by each frame, in clock order
+    std::vector<int> frame_page;
+    // The frame the hand points at: the next candidate victim
+    int hand;
+
+public:
+    /**
+     * @brief Constructor
+     * @param num_pages Total number of logical pages.
+     * @param num_frames Total number of physical frames.
+     */
+    ClockReplacement(int num_pages, int num_frames);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~ClockReplacement();
+
+    /**
+     * @brief Access a page already in memory: set its referenced bit.
+     * @param page_num The logical page number.
+     */
+    virtual void touch_page(int page_num);
+
+    /**
+     * @brief Record a page just loaded into a free frame.
+     * @param page_num The logical page number.
+     */
+    virtual void load_page(int page_num);
+
+    /**
+     * @brief Sweep the hand to the first page without its referenced bit, clearing the bits
+     *        it passes, and replace that page.
+     * @param page_num The logical page number of the desired page.
+     * @return Selected victim page #
+     */
+    virtual int replace_page(int page_num);
+};
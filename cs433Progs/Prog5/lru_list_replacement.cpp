@@ -0,0 +1,84 @@
+/**
+ * Assignment 5: Page replacement algorithms
+ * @file lru_list_replacement.cpp
+ * @author Oscar Lopez
+ * @brief Implementation of true LRU with an index-linked recency list
+ * @version 0.1
+ */
+
+#include "lru_list_replacement.h"
+
+LRUListReplacement::LRUListReplacement(int num_pages, int num_frames)
+: Replacement(num_pages, num_frames),
+  prev_frame(num_frames, -1), next_frame_of(num_frames, -1), frame_page(num_frames, -1),
+  head(-1), tail(-1)
+{
+}
+
+LRUListReplacement::~LRUListReplacement() {
+    // The vectors free themselves
+}
+
+void LRUListReplacement::unlink(int frame) {
+    int prev = prev_frame[frame];
+    int next = next_frame_of[frame];
+    if (prev != -1) {
+        next_frame_of[prev] = next;
+    } else {
+        head = next;
+    }
+    if (next != -1) {
+        prev_frame[next] = prev;
+    } else {
+        tail = prev;
+    }
+}
+
+void LRUListReplacement::push_front(int frame) {
+    prev_frame[frame] = -1;
+    next_frame_of[frame] = head;
+    if (head != -1) {
+        prev_frame[head] = frame;
+    } else {
+        tail = frame;       // the list was empty
+    }
+    head = frame;
+}
+
+void LRUListReplacement::touch_page(int page_num) {
+    int frame = page_table[page_num].frame_num;
+    if (frame != head) {
+        unlink(frame);
+        push_front(frame);
+    }
+    page_table[page_num].referenced = true;
+}
+
+void LRUListReplacement::load_page(int page_num) {
+    // Replacement::access_page has already given the page a free frame
+    int frame = page_table[page_num].frame_num;
+    page_table[page_num].referenced = true;
+    frame_page[frame] = page_num;
+    push_front(frame);
+}
+
+int LRUListReplacement::replace_page(int page_num) {
+    // The least recently used page is at the back of the list
+    int frame = tail;
+    int victim_page = frame_page[frame];
+
+    page_table[victim_page].valid = false;
+    page_table[victim_page].frame_num = -1;
+
+    page_table[page_num].frame_num = frame;
+    page_table[page_num].valid = true;
+    page_table[page_num].referenced = true;
+    frame_page[frame] = page_num;
+
+    // The new page is now the most recently used
+    unlink(frame);
+    push_front(frame);
+
+    page_replacements++;
+    return victim_page;
+}
@@ -0,0 +1,80 @@
+/**
+ * Assignment 5: Page replacement algorithms
+ * @file lru_list_replacement.h
+ * @author Oscar Lopez
+ * @brief A class implementing true LRU with constant-time touch and eviction
+ * @version 0.1
+ *
+ * LRUReplacement finds its victim by scanning the last access time of every page in
+ * memory, which costs O(frames) on every page fault (262,144 frames for 64 MB of 256-byte
+ * pages). This class keeps the frames in a doubly-linked list ordered by recency instead:
+ * a hit moves the page's frame to the front, and the victim is always the frame at the
+ * back. The links are frame numbers stored in two arrays, so the list needs no node
+ * allocation, and a page finds its frame through the page table.
+ */
+
+#pragma once
+
+#include "replacement.h"
+#include <vector>
+
+/**
+ * @brief A class to simulate LRU page replacement with an index-linked recency list.
+ */
+class LRUListReplacement : public Replacement {
+private:
+    // prev_frame[f] / next_frame_of[f]: the frames used just more / less recently than frame f,
+    // -1 at the ends of the list
+    std::vector<int> prev_frame;
+    std::vector<int> next_frame_of;
+    // The page held by each frame
+    std::vector<int> frame_page;
+    // Most recently used frame (front of the list), -1 if empty
+    int head;
+    // Least recently used frame (back of the list), -1 if empty
+    int tail;
+
+    /**
+     * @brief Remove a frame from the recency list.
+     * @param frame The frame number.
+     */
+    void unlink(int frame);
+
+    /**
+     * @brief Insert a frame at the front of the recency list (most recently used).
+     * @param frame The frame number.
+     */
+    void push_front(int frame);
+
+public:
+    /**
+     * @brief Constructor
+     * @param num_pages Total number of logical pages.
+     * @param num_frames Total number of physical frames.
+     */
+    LRUListReplacement(int num_pages, int num_frames);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~LRUListReplacement();
+
+    /**
+     * @brief Access a page already in memory: move its frame to the front of the list. O(1).
+     * @param page_num The logical page number.
+     */
+    virtual void touch_page(int page_num);
+
+    /**
+     * @brief Put a page just loaded into a free frame at the front of the list. O(1).
+     * @param page_num The logical page number.
+     */
+    virtual void load_page(int page_num);
+
+    /**
+     * @brief Evict the page at the back of the list and load the new page into its frame. O(1).
+     * @param page_num The logical page number of the desired page.
+     * @return Selected victim page #
+     */
+    virtual int replace_page(int page_num);
+};
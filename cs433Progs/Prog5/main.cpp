@@ -6,12 +6,17 @@
  * @version 0.1
  * @date 05/07/2024
  * 
- * This program simulates three different page replacement algorithms:
+ * This program simulates these page replacement algorithms:
  * - FIFO (First-In-First-Out)
  * - LIFO (Last-In-First-Out)
- * - LRU (Least Recently Used)
+ * - LRU (Least Recently Used), with a scan for the victim and with a recency list
+ * - CLOCK (Second-Chance), an LRU approximation using the referenced bit
+ * - CLOCK-Pro, which also uses the referenced bit but resists scans
+ * - ARC (Adaptive Replacement Cache) and 2Q, which keep ghost lists of recently
+ *   evicted pages so a sequential scan can't flush the hot working set
  * It reads memory references from input files and compares the performance
- * of these algorithms using various metrics.
+ * of these algorithms using various metrics, ending with a table of fault rate
+ * and time per access.
  */
 
 #include <iostream>
@@ -20,10 +25,17 @@
 #include <cmath>
 #include <vector>
 #include <chrono>  // For timing measurements
+#include <iomanip>
+#include <string>
 
 #include "fifo_replacement.h"
 #include "lru_replacement.h"
+#include "lru_list_replacement.h"
 #include "lifo_replacement.h"
+#include "clock_replacement.h"
+#include "clock_pro_replacement.h"
+#include "arc_replacement.h"
+#include "two_q_replacement.h"
 
 /**
  * @brief Check if an integer is a power of 2
@@ -35,6 +47,45 @@ bool isPowerOfTwo(unsigned int x) {
     return x && (!(x & (x - 1)));
 }
 
+/**
+ * @brief The outcome of one simulation run, for the summary table
+ */
+struct SimulationResult {
+    std::string name;
+    int faults;
+    int references;
+    double seconds;
+};
+
+/**
+ * @brief Run the large reference list through one replacement algorithm and print its statistics
+ * @tparam Policy A subclass of Replacement
+ * @param name The algorithm's name, for the output
+ * @param refs The logical addresses
+ * @param page_offset_bits Num of bits for the page offset
+ * @param num_pages Total number of logical pages
+ * @param num_frames Total number of physical frames
+ * @return The fault count and run time
+ */
+template <typename Policy>
+SimulationResult simulate(const std::string& name, const std::vector<int>& refs, int page_offset_bits,
+                          int num_pages, int num_frames) {
+    std::cout << "\n****************Simulate " << name << " replacement****************************" << std::endl;
+    auto start = std::chrono::high_resolution_clock::now();
+    Policy vm(num_pages, num_frames);
+    for (const auto& addr : refs) {
+        int page_num = addr >> page_offset_bits;
+        vm.access_page(page_num, 0);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+
+    std::cout << name << " Replacement Statistics:" << std::endl;
+    vm.print_statistics();
+    std::cout << "Elapsed time: " << duration.count() << " seconds" << std::endl;
+    return SimulationResult{name, vm.getPageFaults(), vm.getTotalReferences(), duration.count()};
+}
+
 int main(int argc, char *argv[]) {
     //Print basic information about the program
     std::cout << "=================================================================" << std::endl;
@@ -139,52 +190,26 @@ int main(int argc, char *argv[]) {
     }
     large_in.close();
 
-    std::cout << "****************Simulate FIFO replacement****************************" << std::endl;
-    {
-        auto start = std::chrono::high_resolution_clock::now();
-        FIFOReplacement fifo_vm(num_pages, num_frames);
-        for (const auto& addr : large_refs) {
-            int page_num = addr >> page_offset_bits;
-            fifo_vm.access_page(page_num, 0);
-        }
-        auto end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> duration = end - start;
-        
-        std::cout << "FIFO Replacement Statistics:" << std::endl;
-        fifo_vm.print_statistics();
-        std::cout << "Run time: " << duration.count() << " seconds" << std::endl;
-    }
-
-    std::cout << "\n****************Simulate LIFO replacement****************************" << std::endl;
-    {
-        auto start = std::chrono::high_resolution_clock::now();
-        LIFOReplacement lifo_vm(num_pages, num_frames);
-        for (const auto& addr : large_refs) {
-            int page_num = addr >> page_offset_bits;
-            lifo_vm.access_page(page_num, 0);
-        }
-        auto end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> duration = end - start;
-        
-        std::cout << "LIFO Replacement Statistics:" << std::endl;
-        lifo_vm.print_statistics();
-        std::cout << "Run time: " << duration.count() << " seconds" << std::endl;
-    }
+    std::vector<SimulationResult> results;
+    results.push_back(simulate<FIFOReplacement>("FIFO", large_refs, page_offset_bits, num_pages, num_frames));
+    results.push_back(simulate<LIFOReplacement>("LIFO", large_refs, page_offset_bits, num_pages, num_frames));
+    results.push_back(simulate<LRUReplacement>("LRU", large_refs, page_offset_bits, num_pages, num_frames));
+    // Same replacement decisions as LRU, but O(1) per fault instead of a scan of every frame
+    results.push_back(simulate<LRUListReplacement>("LRU (linked list)", large_refs, page_offset_bits,
+                                                   num_pages, num_frames));
+    results.push_back(simulate<ClockReplacement>("CLOCK", large_refs, page_offset_bits, num_pages, num_frames));
+    results.push_back(simulate<ClockProReplacement>("CLOCK-Pro", large_refs, page_offset_bits,
+                                                    num_pages, num_frames));
+    results.push_back(simulate<ARCReplacement>("ARC", large_refs, page_offset_bits, num_pages, num_frames));
+    results.push_back(simulate<TwoQReplacement>("2Q", large_refs, page_offset_bits, num_pages, num_frames));
 
-    std::cout << "\n****************Simulate LRU replacement****************************" << std::endl;
-    {
-        auto start = std::chrono::high_resolution_clock::now();
-        LRUReplacement lru_vm(num_pages, num_frames);
-        for (const auto& addr : large_refs) {
-            int page_num = addr >> page_offset_bits;
-            lru_vm.access_page(page_num, 0);
-        }
-        auto end = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> duration = end - start;
-        
-        std::cout << "LRU Replacement Statistics:" << std::endl;
-        lru_vm.print_statistics();
-        std::cout << "Elapsed time: " << duration.count() << " seconds" << std::endl;
+    std::cout << "\n****************Summary**********************************************" << std::endl;
+    std::cout << std::left << std::setw(20) << "Algorithm" << std::right << std::setw(12) << "Faults"
+              << std::setw(14) << "Fault rate %" << std::setw(14) << "ns/access" << std::endl;
+    for (const SimulationResult& r : results) {
+        std::cout << std::left << std::setw(20) << r.name << std::right << std::setw(12) << r.faults
+                  << std::setw(14) << std::fixed << std::setprecision(2) << 100.0 * r.faults / r.references
+                  << std::setw(14) << std::setprecision(1) << r.seconds * 1e9 / r.references << std::endl;
     }
 
     return 0;
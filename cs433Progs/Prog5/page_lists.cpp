@@ -0,0 +1,56 @@
+/**
+ * Assignment 5: Page replacement algorithms
+ * @file page_lists.cpp
+ * @author Oscar Lopez
+ * @brief Implementation of the array-linked page lists
+ * @version 0.1
+ */
+
+#include "page_lists.h"
+
+PageLists::PageLists(int num_pages, int num_lists)
+: prev_page(num_pages, -1), next_page(num_pages, -1), owner(num_pages, -1),
+  heads(num_lists, -1), tails(num_lists, -1), sizes(num_lists, 0)
+{
+}
+
+void PageLists::push_front(int list, int page_num) {
+    int head = heads[list];
+    prev_page[page_num] = -1;
+    next_page[page_num] = head;
+    if (head != -1) {
+        prev_page[head] = page_num;
+    } else {
+        tails[list] = page_num;     // the list was empty
+    }
+    heads[list] = page_num;
+    owner[page_num] = list;
+    sizes[list]++;
+}
+
+void PageLists::remove(int page_num) {
+    int list = owner[page_num];
+    int prev = prev_page[page_num];
+    int next = next_page[page_num];
+    if (prev != -1) {
+        next_page[prev] = next;
+    } else {
+        heads[list] = next;
+    }
+    if (next != -1) {
+        prev_page[next] = prev;
+    } else {
+        tails[list] = prev;
+    }
+    prev_page[page_num] = next_page[page_num] = -1;
+    owner[page_num] = -1;
+    sizes[list]--;
+}
+
+int PageLists::pop_back(int list) {
+    int page_num = tails[list];
+    if (page_num != -1) {
+        remove(page_num);
+    }
+    return page_num;
+}
@@ -0,0 +1,77 @@
+/**
+ * Assignment 5: Page replacement algorithms
+ * @file page_lists.h
+ * @author Oscar Lopez
+ * @brief A set of doubly linked lists of page numbers, for algorithms that keep several queues
+ * @version 0.1
+ *
+ * ARC and 2Q move pages between several recency queues, some holding resident pages and some
+ * holding "ghost" entries that only remember a page was evicted recently. A page is on at most
+ * one of the lists at a time, so one pair of prev/next arrays indexed by page number links
+ * all of them: every operation is O(1) and nothing is hashed or allocated after construction.
+ * The front of a list is its most recently inserted end.
+ */
+
+#pragma once
+
+#include <vector>
+
+/**
+ * @brief Doubly linked lists of page numbers, linked through arrays sized to the page table.
+ */
+class PageLists {
+private:
+    // Links of each page within its list; -1 = no neighbour
+    std::vector<int> prev_page;
+    std::vector<int> next_page;
+    // The list each page is on; -1 = none
+    std::vector<int> owner;
+    // Per list
+    std::vector<int> heads;
+    std::vector<int> tails;
+    std::vector<int> sizes;
+
+public:
+    /**
+     * @brief Constructor
+     * @param num_pages Total number of logical pages.
+     * @param num_lists Number of lists.
+     */
+    PageLists(int num_pages, int num_lists);
+
+    /**
+     * @brief Get the list a page is on.
+     * @param page_num The logical page number.
+     * @return The list, or -1 if the page is on none
+     */
+    int list_of(int page_num) const {
+        return owner[page_num];
+    }
+
+    /**
+     * @brief Get the number of pages on a list.
+     */
+    int size(int list) const {
+        return sizes[list];
+    }
+
+    /**
+     * @brief Insert a page at the front of a list. The page must not be on any list.
+     * @param list The list.
+     * @param page_num The logical page number.
+     */
+    void push_front(int list, int page_num);
+
+    /**
+     * @brief Remove a page from the list it is on.
+     * @param page_num The logical page number.
+     */
+    void remove(int page_num);
+
+    /**
+     * @brief Remove the page at the back (least recently inserted end) of a list.
+     * @param list The list.
+     * @return The page removed, or -1 if the list is empty
+     */
+    int pop_back(int list);
+};
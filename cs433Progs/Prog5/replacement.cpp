@@ -26,23 +26,37 @@ Replacement::Replacement(int num_pages, int num_frames)
 		free_frames[i] = true;  // All frames are initially free
 	}
 	next_frame = 0;
+	released_frames = new int[num_frames];
+	num_released = 0;
 }
 
 // Destructor: Clean up any allocated memory
 Replacement::~Replacement()
 {
 	delete[] free_frames;
+	delete[] released_frames;
 }
 
 // Helper function to find the next free frame
+// Frames released by evictions are reused first; otherwise frames are handed out in order
+// 0, 1, 2... so a fault never scans the frames
 int Replacement::find_free_frame() {
-	for (int i = 0; i < num_frames; i++) {
-		if (free_frames[i]) {
-			free_frames[i] = false;  // Mark as used
-			return i;
-		}
+	int frame;
+	if (num_released > 0) {
+		frame = released_frames[--num_released];
+	} else if (next_frame < num_frames) {
+		frame = next_frame++;
+	} else {
+		return -1;  // No free frames available
 	}
-	return -1;  // No free frames available
+	free_frames[frame] = false;  // Mark as used
+	return frame;
+}
+
+// Helper function to give back a frame whose page was evicted without a replacement
+void Replacement::release_frame(int frame) {
+	free_frames[frame] = true;
+	released_frames[num_released++] = frame;
 }
 
 // Simulate a single page access 
@@ -63,6 +77,7 @@ bool Replacement::access_page(int page_num, bool is_write)
 	
 	// Page fault occurred
 	page_faults++;
+	page_table[page_num].dirty = is_write;
 	
 	// Try to find a free frame
 	int frame = find_free_frame();
@@ -70,7 +85,6 @@ bool Replacement::access_page(int page_num, bool is_write)
 		// We have a free frame available
 		page_table[page_num].frame_num = frame;
 		page_table[page_num].valid = true;
-		page_table[page_num].dirty = is_write;
 		load_page(page_num);
 	} else {
 		// No free frames, need to replace a page
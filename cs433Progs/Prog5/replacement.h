@@ -28,15 +28,21 @@ protected:      // subclasses can access these members
     int num_frames;
     // Array to keep track of which frames are currently free
     bool* free_frames;
-    // Next available frame number
+    // Next available frame number: frames below it have been handed out at least once
     int next_frame;
+    // Stack of frames released by release_frame(), reused before next_frame
+    int* released_frames;
+    int num_released;
     // Statistics counters
     int page_faults;
     int page_replacements;
     int total_references;
 	
-    // Helper function to find next free frame
+    // Helper function to find next free frame, in O(1); returns -1 if none is free
     int find_free_frame();
+
+    // Helper function to give back the frame of an evicted page, for find_free_frame() to reuse
+    void release_frame(int frame);
 	
 public:
 	/**
@@ -95,6 +101,20 @@ public:
         return page_table[page_num];
     }
 
+    /**
+	 * @brief Get the number of page faults so far
+	 */
+    int getPageFaults() const {
+        return page_faults;
+    }
+
+    /**
+	 * @brief Get the number of memory references so far
+	 */
+    int getTotalReferences() const {
+        return total_references;
+    }
+
     /**
 	 * @brief Print the statistics of simulation
 	 */
@@ -0,0 +1,71 @@
+/**
+ * Assignment 5: Page replacement algorithms
+ * @file two_q_replacement.cpp
+ * @author Oscar Lopez
+ * @brief Implementation of the 2Q page replacement algorithm
+ * @version 0.1
+ */
+
+#include "two_q_replacement.h"
+#include <algorithm>
+
+TwoQReplacement::TwoQReplacement(int num_pages, int num_frames)
+: Replacement(num_pages, num_frames), lists(num_pages, NUM_LISTS),
+  max_in(std::max(1, num_frames / 4)), max_out(std::max(1, num_frames / 2)), last_victim(-1)
+{
+}
+
+TwoQReplacement::~TwoQReplacement() {
+    // The lists free themselves
+}
+
+void TwoQReplacement::make_room() {
+    int victim;
+    if (lists.size(A1_IN) > max_in || lists.size(AM) == 0) {
+        victim = lists.pop_back(A1_IN);
+        lists.push_front(A1_OUT, victim);
+        if (lists.size(A1_OUT) > max_out) {
+            lists.pop_back(A1_OUT);
+        }
+    } else {
+        victim = lists.pop_back(AM);
+    }
+
+    release_frame(page_table[victim].frame_num);
+    page_table[victim].valid = false;
+    page_table[victim].frame_num = -1;
+    last_victim = victim;
+}
+
+void TwoQReplacement::admit(int page_num) {
+    if (lists.list_of(page_num) == A1_OUT) {
+        // Referenced again after leaving A1in: it belongs to the hot set
+        lists.remove(page_num);
+        lists.push_front(AM, page_num);
+    } else {
+        lists.push_front(A1_IN, page_num);
+    }
+    page_table[page_num].referenced = true;
+}
+
+void TwoQReplacement::touch_page(int page_num) {
+    if (lists.list_of(page_num) == AM) {
+        lists.remove(page_num);
+        lists.push_front(AM, page_num);
+    }
+    page_table[page_num].referenced = true;
+}
+
+void TwoQReplacement::load_page(int page_num) {
+    admit(page_num);
+}
+
+int TwoQReplacement::replace_page(int page_num) {
+    make_room();
+    admit(page_num);
+    // make_room() freed the victim's frame
+    page_table[page_num].frame_num = find_free_frame();
+    page_table[page_num].valid = true;
+    page_replacements++;
+    return last_victim;
+}
@@ -0,0 +1,84 @@
+/**
+ * Assignment 5: Page replacement algorithms
+ * @file two_q_replacement.h
+ * @author Oscar Lopez
+ * @brief A class implementing the 2Q page replacement algorithm
+ * @version 0.1
+ *
+ * 2Q (Johnson and Shasha, VLDB 1994; the "full version") admits a new page into A1in, a small
+ * FIFO of resident pages. A page that reaches the end of A1in is evicted but remembered in
+ * A1out, a ghost FIFO. Only a page that faults again while in A1out is promoted to Am, the LRU
+ * list that holds the hot set. A scan touches each page once, so it cycles through A1in and
+ * A1out and never pushes anything out of Am. The sizes follow the paper's suggestion:
+ * A1in gets a quarter of the frames and A1out remembers half as many pages as there are frames.
+ */
+
+#pragma once
+
+#include "replacement.h"
+#include "page_lists.h"
+
+/**
+ * @brief A class to simulate the 2Q page replacement algorithm.
+ */
+class TwoQReplacement : public Replacement {
+private:
+    // The lists in `lists`
+    enum {
+        A1_IN,      // resident, first reference, FIFO
+        A1_OUT,     // ghosts evicted from A1in, FIFO
+        AM,         // resident, referenced again after leaving A1in, LRU
+        NUM_LISTS
+    };
+
+    PageLists lists;
+    // Size threshold of A1in and capacity of A1out
+    int max_in;
+    int max_out;
+    // The page evicted by the last fault
+    int last_victim;
+
+    /**
+     * @brief Evict the back of A1in (remembering it in A1out) or of Am, freeing a frame.
+     */
+    void make_room();
+
+    /**
+     * @brief Put a faulted page on A1in, or on Am if it was remembered in A1out.
+     * @param page_num The logical page number.
+     */
+    void admit(int page_num);
+
+public:
+    /**
+     * @brief Constructor
+     * @param num_pages Total number of logical pages.
+     * @param num_frames Total number of physical frames.
+     */
+    TwoQReplacement(int num_pages, int num_frames);
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~TwoQReplacement();
+
+    /**
+     * @brief Access a page already in memory: move it to the front of Am if it is there.
+     *        A hit in A1in changes nothing, since those are usually correlated references.
+     * @param page_num The logical page number.
+     */
+    virtual void touch_page(int page_num);
+
+    /**
+     * @brief Put a page just loaded into a free frame on A1in or Am.
+     * @param page_num The logical page number.
+     */
+    virtual void load_page(int page_num);
+
+    /**
+     * @brief Evict a page from A1in or Am and load the new page in its frame.
+     * @param page_num The logical page number of the desired page.
+     * @return Selected victim page #
+     */
+    virtual int replace_page(int page_num);
+};